@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace fol::details::utils {
+// Read-only mapping of a whole file
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::system_error{errno, std::generic_category(), path};
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) < 0) {
+      auto error = errno;
+      ::close(fd);
+      throw std::system_error{error, std::generic_category(), path};
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+      void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error{error, std::generic_category(), path};
+      }
+      ::madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char *>(data);
+    }
+    ::close(fd);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&o) noexcept
+      : data_(std::exchange(o.data_, nullptr)),
+        size_(std::exchange(o.size_, 0)) {}
+
+  MappedFile &operator=(MappedFile &&o) noexcept {
+    std::swap(data_, o.data_);
+    std::swap(size_, o.size_);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (data_) {
+      ::munmap(const_cast<char *>(data_), size_);
+    }
+  }
+
+  std::string_view view() const { return {data_, size_}; }
+
+ private:
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+}  // namespace fol::details::utils
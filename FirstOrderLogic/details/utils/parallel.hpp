@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fol::details::utils {
+// Work-stealing pool of jobs - 1 worker threads, a thread calling ForEach
+// being the last one. Every thread pushes its tasks to a deque of its own and
+// takes its newest task first; a thread without tasks steals the oldest task
+// of another one. A thread waiting in ForEach runs pending tasks meanwhile,
+// so tasks may call ForEach themselves, and sleeps while there are none.
+class TaskPool {
+ public:
+  explicit TaskPool(std::size_t jobs)
+      : queues_(std::max<std::size_t>(jobs, 1)) {
+    workers_.reserve(queues_.size() - 1);
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+      workers_.emplace_back([this, i] { Work(i); });
+    }
+  }
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  ~TaskPool() {
+    {
+      std::lock_guard lock{sleep_mutex_};
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  // The pool running the current task or ForEach on this thread, if any
+  static TaskPool *Current() { return current_; }
+
+  // Calls f(i) for every i in [0, count) and waits for all the calls. Once
+  // every call has finished, the exception of the lowest failed index is
+  // rethrown.
+  template <class F>
+  void ForEach(std::size_t count, F &&f) {
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<std::size_t> pending = count;
+    const auto index = current_ == this ? index_ : 0;
+    // counted before they are published, a thread taking one decrements it
+    {
+      std::lock_guard lock{sleep_mutex_};
+      queued_ += count;
+    }
+    {
+      std::lock_guard lock{queues_[index].mutex};
+      // owner pops from the back, index 0 first
+      for (std::size_t i = count; i-- > 0;) {
+        queues_[index].tasks.emplace_back([&, i] {
+          try {
+            f(i);
+          } catch (...) {
+            errors[i] = std::current_exception();
+          }
+          if (--pending == 0) {
+            // the waiter checks pending under the lock, so it cannot miss this
+            std::lock_guard lock{sleep_mutex_};
+            wake_.notify_all();
+          }
+        });
+      }
+    }
+    wake_.notify_all();
+
+    auto previous = std::exchange(current_, this);
+    auto previous_index = std::exchange(index_, index);
+    while (pending > 0) {
+      if (RunOne(index)) {
+        continue;
+      }
+      // the other calls are running on other threads
+      std::unique_lock lock{sleep_mutex_};
+      wake_.wait(lock, [&] { return pending == 0 || queued_ > 0; });
+    }
+    current_ = previous;
+    index_ = previous_index;
+
+    for (auto &error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void Work(std::size_t index) {
+    current_ = this;
+    index_ = index;
+    while (true) {
+      if (RunOne(index)) {
+        continue;
+      }
+      std::unique_lock lock{sleep_mutex_};
+      wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+      if (stop_) {
+        return;
+      }
+    }
+  }
+
+  // Runs the newest own task or the oldest one of another thread
+  bool RunOne(std::size_t index) {
+    std::function<void()> task;
+    for (std::size_t i = 0; i < queues_.size() && !task; ++i) {
+      auto &queue = queues_[(index + i) % queues_.size()];
+      std::lock_guard lock{queue.mutex};
+      if (queue.tasks.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+    if (!task) {
+      return false;
+    }
+    {
+      std::lock_guard lock{sleep_mutex_};
+      --queued_;
+    }
+    task();
+    return true;
+  }
+
+  static inline thread_local TaskPool *current_ = nullptr;
+  static inline thread_local std::size_t index_ = 0;
+
+  std::vector<Queue> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::size_t queued_ = 0;
+  bool stop_ = false;
+};
+}  // namespace fol::details::utils
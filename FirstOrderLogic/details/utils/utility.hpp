@@ -119,14 +119,15 @@ inline T GetValueFromGenerator(cppcoro::generator<T> &generator) {
 inline std::vector<std::string> Split(std::string str, std::string delim) {
   std::vector<std::string> words{};
 
+  size_t begin = 0;
   size_t pos = 0;
-  while ((pos = str.find(delim)) != std::string::npos) {
-    words.push_back(str.substr(0, pos));
-    str.erase(0, pos + delim.length());
+  while ((pos = str.find(delim, begin)) != std::string::npos) {
+    words.push_back(str.substr(begin, pos - begin));
+    begin = pos + delim.length();
   }
 
-  if (!str.empty()) {
-    words.push_back(str);
+  if (begin < str.size()) {
+    words.push_back(str.substr(begin));
   }
 
   return words;
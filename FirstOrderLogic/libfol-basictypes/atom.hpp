@@ -15,7 +15,16 @@ class Atom {
 
   Atom(parser::PredicateFormula formula)
       : predicate_name_(formula.data.first),
-        term_list_(FromTermList(std::move(formula.data.second))) {}
+        term_list_(FromTermList(std::move(formula.data.second))) {
+    UpdateInfo();
+  }
+
+  Atom(bool negative, std::string predicate_name, std::vector<Term> terms)
+      : negative_(negative),
+        predicate_name_(std::move(predicate_name)),
+        term_list_(std::move(terms)) {
+    UpdateInfo();
+  }
 
   Atom(parser::NotFormula formula);
 
@@ -24,7 +33,9 @@ class Atom {
   Atom(Atom&& a) { a.swap(*this); }
 
   Atom(const Atom& a)
-      : negative_(a.negative_), predicate_name_(a.predicate_name_) {
+      : negative_(a.negative_),
+        predicate_name_(a.predicate_name_),
+        info_(a.info_) {
     term_list_.reserve(a.terms_size());
     for (auto& t : a.term_list_) {
       term_list_.push_back(Clone(t));
@@ -41,6 +52,7 @@ class Atom {
     o.term_list_.swap(term_list_);
     o.predicate_name_.swap(predicate_name_);
     std::swap(o.negative_, negative_);
+    std::swap(o.info_, info_);
   }
 
   bool operator==(const Atom& o) const;
@@ -49,17 +61,33 @@ class Atom {
 
   void Substitute(const Variable& from, const Term& to);
 
+  // Calls f with every term, which f may change in place, and keeps info()
+  // current
+  template <class F>
+  void ModifyTerms(F&& f) {
+    for (auto& term : term_list_) {
+      f(term);
+    }
+    UpdateInfo();
+  }
+
+  void Negate() { negative_ = !negative_; }
+
+  // depth and weight count the predicate symbol
+  const parser::TermInfo& info() const { return info_; }
+
   bool negative() const { return negative_; }
   const Term& operator[](std::size_t i) const { return term_list_[i]; }
-  Term& operator[](std::size_t i) { return term_list_[i]; }
   const auto& terms() const { return term_list_; }
-  auto& terms() { return term_list_; }
   std::size_t terms_size() const { return term_list_.size(); }
   const std::string& predicate_name() const { return predicate_name_; }
 
  private:
+  void UpdateInfo();
+
   bool negative_ = false;
   std::string predicate_name_;
   std::vector<Term> term_list_;
+  parser::TermInfo info_;
 };
 }  // namespace fol::types
@@ -5,7 +5,11 @@
 namespace fol::types {
 class BasicClausesStorageFactory : public IClausesStorageFactory {
  public:
-  std::pair<std::unique_ptr<IClausesStorage>, std::unique_ptr<IClausesStorage>>
-  create(std::vector<Clause> axioms, std::vector<Clause> hypothesis) override;
+  using IClausesStorageFactory::create;
+
+  Storages create() override;
+
+  void Insert(Storages& storages, const Clause& clause,
+              bool hypothesis) override;
 };
 }  // namespace fol::types
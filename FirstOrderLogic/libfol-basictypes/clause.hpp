@@ -11,7 +11,7 @@ class Clause {
 
   Clause() = default;
 
-  Clause(const std::vector<Atom>& atoms) : atoms_(atoms) {
+  Clause(std::vector<Atom> atoms) : atoms_(std::move(atoms)) {
     std::sort(atoms_.begin(), atoms_.end());
   }
   Clause(parser::FolFormula disj);
@@ -43,6 +43,9 @@ class Clause {
 
   std::size_t id() const { return id_; }
 
+  // Id of the last clause made, later clauses get greater ids
+  static std::size_t last_id() { return counter; }
+
   bool empty() const { return atoms_.empty(); }
 
  private:
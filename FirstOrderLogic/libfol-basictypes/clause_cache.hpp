@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libfol-basictypes/clause.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fol::types {
+// FNV-1a, chained through seed
+std::uint64_t ContentHash(std::string_view data,
+                          std::uint64_t seed = 0xcbf29ce484222325);
+
+// Clauses of a problem part and the counters of the normalization context
+// that produced them, so later names do not clash with theirs
+struct CachedClauses {
+  std::vector<Clause> clauses;
+  std::size_t names = 0;
+  std::size_t functions = 0;
+};
+
+// Binary image: a header with the key and the version of the producer, the
+// symbol table and the literals of every clause with their terms in prefix
+// order. Integers are little endian.
+std::string Serialize(std::uint64_t key, std::uint32_t version,
+                      const CachedClauses& cached);
+
+// Empty if data is not an image of key written by version
+std::optional<CachedClauses> Deserialize(std::string_view data,
+                                         std::uint64_t key,
+                                         std::uint32_t version);
+
+// Directory of images named by their key. Images are mapped when loaded and
+// replaced atomically when stored. Images of another producer version are
+// stale.
+class ClauseCache {
+ public:
+  ClauseCache(std::string directory, std::uint32_t version)
+      : directory_(std::move(directory)), version_(version) {}
+
+  // Empty on a miss or a stale image
+  std::optional<CachedClauses> Load(std::uint64_t key) const;
+
+  // Throws std::system_error if the image can not be written
+  void Store(std::uint64_t key, const CachedClauses& cached) const;
+
+  std::string Path(std::uint64_t key) const;
+
+ private:
+  std::string directory_;
+  std::uint32_t version_;
+};
+}  // namespace fol::types
@@ -1,12 +1,34 @@
 #pragma once
 
 #include <libfol-basictypes/clauses_storage_interface.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace fol::types {
 class IClausesStorageFactory {
  public:
-  virtual std::pair<std::unique_ptr<IClausesStorage>,
-                    std::unique_ptr<IClausesStorage>>
-  create(std::vector<Clause> axioms, std::vector<Clause> hypothesis) = 0;
+  using Storages = std::pair<std::unique_ptr<IClausesStorage>,
+                             std::unique_ptr<IClausesStorage>>;
+
+  // Empty storages, the input clauses are put into them with Insert as they
+  // are produced
+  virtual Storages create() = 0;
+
+  // Puts an input clause into its storage. The axioms are inserted before the
+  // hypothesis.
+  virtual void Insert(Storages& storages, const Clause& clause,
+                      bool hypothesis) = 0;
+
+  Storages create(std::vector<Clause> axioms, std::vector<Clause> hypothesis) {
+    auto storages = create();
+    for (auto& clause : axioms) {
+      Insert(storages, clause, false);
+    }
+    for (auto& clause : hypothesis) {
+      Insert(storages, clause, true);
+    }
+    return storages;
+  }
 };
 }  // namespace fol::types
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <details/utils/mapped_file.hpp>
+#include <libfol-basictypes/clause.hpp>
+#include <libfol-parser/parser/problem_reader.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fol::types {
+struct CnfProblem {
+  std::vector<Clause> axioms;
+  // clauses of the already negated hypothesis
+  std::vector<Clause> hypothesis;
+};
+
+// Reads problems that are already in clausal form and builds clauses straight
+// from tokens, without normalization. Two layouts are accepted:
+//  - TPTP-like statements cnf(name, role, clause). where clauses of the
+//    negated_conjecture role go to the hypothesis and the rest to the axioms,
+//    % starts a comment line;
+//  - the layout of remade_teorems with one clause per line: the number of
+//    axiom clauses, the axiom clauses and the hypothesis clauses.
+// A clause is a disjunction of literals joined by or or |, symbols are
+// spelled as in formulas. Variables are renamed apart in every clause.
+// Errors are ProblemError prefixed with <file>:<line>:<column>:
+class CnfReader {
+ public:
+  explicit CnfReader(const std::string& path);
+
+  // name is only used in error messages
+  CnfReader(std::string name, std::string source);
+
+  CnfReader(const CnfReader&) = delete;
+  CnfReader& operator=(const CnfReader&) = delete;
+
+  CnfProblem Read();
+
+  const std::string& name() const { return name_; }
+
+ private:
+  void ReadStatements(CnfProblem& problem);
+
+  void ReadLines(CnfProblem& problem);
+
+  Clause ParseClause(std::string_view::size_type begin,
+                     std::string_view::size_type end) const;
+
+  [[noreturn]] void Fail(std::string_view::size_type position,
+                         const std::string& what) const;
+
+  std::string name_;
+  std::optional<details::utils::MappedFile> file_;
+  std::string buffer_;
+  std::string_view source_;
+};
+}  // namespace fol::types
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <libfol-basictypes/atom.hpp>
 #include <libfol-matcher/matcher.hpp>
 #include <libfol-parser/parser/print.hpp>
@@ -51,6 +52,17 @@ void Atom::Substitute(const Variable& from, const Term& to) {
   for (auto& term : term_list_) {
     transform::ReplaceTermVar(term, from, to);
   }
+  UpdateInfo();
+}
+
+void Atom::UpdateInfo() {
+  info_ = parser::TermInfo{};
+  for (auto& term : term_list_) {
+    info_.ground = info_.ground && term.info().ground;
+    info_.vars |= term.info().vars;
+    info_.depth = std::max(info_.depth, term.info().depth + 1);
+    info_.weight += term.info().weight;
+  }
 }
 
 bool Atom::operator==(const Atom& o) const {
@@ -23,15 +23,13 @@ void BasicClausesStorage::AddClause(const Clause& c) {
 
 std::vector<Clause> BasicClausesStorage::Infer(
     const Clause& c, const unification::IUnificator& unificator) const {
-  std::vector<Clause> res;
+  std::vector<const Clause*> clauses;
+  clauses.reserve(storage_.size());
 
   for (auto& c_s : storage_) {
-    auto o_c = unificator.Resolution(c, c_s);
-    if (o_c) {
-      res.push_back(*o_c);
-    }
+    clauses.push_back(&c_s);
   }
 
-  return res;
+  return unificator.Resolutions(c, clauses);
 }
 }  // namespace fol::types
@@ -3,12 +3,13 @@
 
 namespace fol::types {
 
-std::pair<std::unique_ptr<IClausesStorage>, std::unique_ptr<IClausesStorage>>
-BasicClausesStorageFactory::create(std::vector<Clause> axioms,
-                                   std::vector<Clause> hypothesis) {
-  axioms.reserve(hypothesis.size() + axioms.size());
-  axioms.insert(axioms.end(), hypothesis.begin(), hypothesis.end());
-  return {std::make_unique<BasicClausesStorage>(std::move(axioms)),
+IClausesStorageFactory::Storages BasicClausesStorageFactory::create() {
+  return {std::make_unique<BasicClausesStorage>(),
           std::make_unique<BasicClausesStorage>()};
 }
+
+void BasicClausesStorageFactory::Insert(Storages& storages,
+                                        const Clause& clause, bool) {
+  storages.first->AddClause(clause);
+}
 }  // namespace fol::types
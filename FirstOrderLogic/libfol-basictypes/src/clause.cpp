@@ -1,25 +1,74 @@
 #include <details/utils/utility.hpp>
 #include <libfol-basictypes/clause.hpp>
-#include <libfol-parser/parser/print.hpp>
-#include <libfol-transform/normalization.hpp>
+#include <stdexcept>
+#include <variant>
 
 namespace fol::types {
 namespace {
-static std::vector<Atom> DisjunctionFormulaToAtoms(parser::FolFormula disj) {
-  disj = transform::DeleteUselessBrackets(std::move(disj));
-  auto str = parser::ToString(disj);
+void CollectLiterals(parser::FolFormula formula, std::vector<Atom>& atoms);
 
-  auto atoms_str = details::utils::Split(str, " or ");
+void CollectLiteral(parser::UnaryFormula unary, bool negative,
+                    std::vector<Atom>& atoms) {
+  std::visit(
+      details::utils::Overloaded{
+          [&](parser::PredicateFormula& pred) {
+            atoms.emplace_back(
+                negative, std::move(pred.data.first.base()),
+                parser::FromTermList(std::move(pred.data.second)));
+          },
+          [&](parser::NotFormula& not_formula) {
+            CollectLiteral(std::move(*not_formula.data), !negative, atoms);
+          },
+          [&](parser::BracketFormula& bracket) {
+            if (!negative) {
+              CollectLiterals(std::move(bracket.data), atoms);
+              return;
+            }
+            std::vector<Atom> inner;
+            CollectLiterals(std::move(bracket.data), inner);
+            if (inner.size() != 1) {
+              throw std::invalid_argument(
+                  "Clause(parser::FolFormula): negated disjunction");
+            }
+            inner.front().Negate();
+            atoms.push_back(std::move(inner.front()));
+          },
+          [](auto&) {
+            throw std::invalid_argument(
+                "Clause(parser::FolFormula): quantifier in a clause");
+          }},
+      unary.data);
+}
 
-  std::vector<Atom> atoms;
-  atoms.reserve(atoms_str.size());
+// Literals of a disjunction, brackets around disjunctions are flattened
+void CollectLiterals(parser::FolFormula formula, std::vector<Atom>& atoms) {
+  auto disj = std::get_if<parser::DisjunctionFormula>(&formula.data);
+  if (!disj) {
+    throw std::invalid_argument(
+        "Clause(parser::FolFormula): implication in a clause");
+  }
+
+  auto literal = [&](parser::ConjunctionFormula& conj) {
+    if (!std::holds_alternative<lexer::EPS>(conj.data->second.data)) {
+      throw std::invalid_argument(
+          "Clause(parser::FolFormula): conjunction in a clause");
+    }
+    CollectLiteral(std::move(conj.data->first), false, atoms);
+  };
 
-  for (auto& s : atoms_str) {
-    atoms.push_back(Atom(parser::Parse(lexer::Tokenize(s))));
+  literal(disj->data.first);
+  for (auto* tail = &disj->data.second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<0>(tail->data);
+    literal(next.first);
+    tail = &next.second;
   }
+}
 
+std::vector<Atom> DisjunctionFormulaToAtoms(parser::FolFormula disj) {
+  std::vector<Atom> atoms;
+  CollectLiterals(std::move(disj), atoms);
   std::sort(atoms.begin(), atoms.end());
-
   return atoms;
 }
 }  // namespace
@@ -0,0 +1,256 @@
+#include <cerrno>
+#include <cstdio>
+#include <details/utils/mapped_file.hpp>
+#include <filesystem>
+#include <fstream>
+#include <libfol-basictypes/clause_cache.hpp>
+#include <system_error>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace fol::types {
+namespace {
+constexpr std::string_view kMagic = "FOLCLAUS";
+constexpr std::uint32_t kVersion = 1;
+
+enum TermKind : std::uint8_t { CONSTANT, VARIABLE, FUNCTION };
+
+class Writer {
+ public:
+  template <class T>
+  void Put(T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      out_.push_back(static_cast<char>(value >> (8 * i) & 0xff));
+    }
+  }
+
+  void PutBytes(std::string_view bytes) { out_.append(bytes); }
+
+  void PutSymbol(const std::string& name) {
+    auto [it, inserted] = symbols_.try_emplace(name, symbols_.size());
+    if (inserted) {
+      names_.push_back(&it->first);
+    }
+    Put<std::uint32_t>(it->second);
+  }
+
+  void PutTerm(const Term& term) {
+    if (term.IsConstant()) {
+      Put<std::uint8_t>(CONSTANT);
+      PutSymbol(term.Const());
+    } else if (term.IsVar()) {
+      Put<std::uint8_t>(VARIABLE);
+      PutSymbol(term.Var());
+    } else {
+      Put<std::uint8_t>(FUNCTION);
+      PutSymbol(term.Function().data->first);
+      std::uint32_t arity = 0;
+      for (auto it = parser::FunctionTermsIt(term.Function());
+           it != parser::ConstTermListIt{}; ++it) {
+        ++arity;
+      }
+      Put(arity);
+      for (auto it = parser::FunctionTermsIt(term.Function());
+           it != parser::ConstTermListIt{}; ++it) {
+        PutTerm(*it);
+      }
+    }
+  }
+
+  std::string& out() { return out_; }
+
+  const std::vector<const std::string*>& names() const { return names_; }
+
+ private:
+  std::string out_;
+  std::unordered_map<std::string, std::uint32_t> symbols_;
+  std::vector<const std::string*> names_;
+};
+
+struct InvalidImage {};
+
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_(data) {}
+
+  template <class T>
+  T Get() {
+    auto bytes = GetBytes(sizeof(T));
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      value |= static_cast<T>(static_cast<unsigned char>(bytes[i]))
+               << (8 * i);
+    }
+    return value;
+  }
+
+  std::string_view GetBytes(std::size_t size) {
+    if (data_.size() - position_ < size) {
+      throw InvalidImage{};
+    }
+    auto bytes = data_.substr(position_, size);
+    position_ += size;
+    return bytes;
+  }
+
+  std::string_view GetSymbol() {
+    auto id = Get<std::uint32_t>();
+    if (id >= symbols_.size()) {
+      throw InvalidImage{};
+    }
+    return symbols_[id];
+  }
+
+  Term GetTerm() {
+    switch (Get<std::uint8_t>()) {
+      case CONSTANT:
+        return {lexer::Constant{GetSymbol()}};
+      case VARIABLE:
+        return {lexer::Variable{GetSymbol()}};
+      case FUNCTION: {
+        lexer::Function function{GetSymbol()};
+        return {std::move(function) * parser::ToTermList(GetTerms())};
+      }
+      default:
+        throw InvalidImage{};
+    }
+  }
+
+  // at least one term
+  std::vector<Term> GetTerms() {
+    auto arity = Get<std::uint32_t>();
+    if (arity == 0 || arity > data_.size() - position_) {
+      throw InvalidImage{};
+    }
+    std::vector<Term> terms;
+    terms.reserve(arity);
+    for (std::uint32_t i = 0; i < arity; ++i) {
+      terms.push_back(GetTerm());
+    }
+    return terms;
+  }
+
+  bool done() const { return position_ == data_.size(); }
+
+  std::vector<std::string_view>& symbols() { return symbols_; }
+
+ private:
+  std::string_view data_;
+  std::size_t position_ = 0;
+  std::vector<std::string_view> symbols_;
+};
+}  // namespace
+
+std::uint64_t ContentHash(std::string_view data, std::uint64_t seed) {
+  for (unsigned char c : data) {
+    seed = (seed ^ c) * 0x100000001b3;
+  }
+  return seed;
+}
+
+std::string Serialize(std::uint64_t key, std::uint32_t version,
+                      const CachedClauses& cached) {
+  Writer body;
+  body.Put<std::uint32_t>(cached.clauses.size());
+  for (auto& clause : cached.clauses) {
+    body.Put<std::uint32_t>(clause.atoms().size());
+    for (auto& atom : clause.atoms()) {
+      body.Put<std::uint8_t>(atom.negative());
+      body.PutSymbol(atom.predicate_name());
+      body.Put<std::uint32_t>(atom.terms_size());
+      for (auto& term : atom.terms()) {
+        body.PutTerm(term);
+      }
+    }
+  }
+
+  Writer image;
+  image.PutBytes(kMagic);
+  image.Put(kVersion);
+  image.Put(key);
+  image.Put(version);
+  image.Put<std::uint64_t>(cached.names);
+  image.Put<std::uint64_t>(cached.functions);
+  image.Put<std::uint32_t>(body.names().size());
+  for (auto name : body.names()) {
+    image.Put<std::uint32_t>(name->size());
+    image.PutBytes(*name);
+  }
+  image.PutBytes(body.out());
+  return std::move(image.out());
+}
+
+std::optional<CachedClauses> Deserialize(std::string_view data,
+                                         std::uint64_t key,
+                                         std::uint32_t version) {
+  try {
+    Reader reader{data};
+    if (reader.GetBytes(kMagic.size()) != kMagic ||
+        reader.Get<std::uint32_t>() != kVersion ||
+        reader.Get<std::uint64_t>() != key ||
+        reader.Get<std::uint32_t>() != version) {
+      return std::nullopt;
+    }
+
+    CachedClauses cached;
+    cached.names = reader.Get<std::uint64_t>();
+    cached.functions = reader.Get<std::uint64_t>();
+
+    auto symbols_count = reader.Get<std::uint32_t>();
+    for (std::uint32_t i = 0; i < symbols_count; ++i) {
+      reader.symbols().push_back(
+          reader.GetBytes(reader.Get<std::uint32_t>()));
+    }
+
+    auto clauses_count = reader.Get<std::uint32_t>();
+    for (std::uint32_t i = 0; i < clauses_count; ++i) {
+      auto atoms_count = reader.Get<std::uint32_t>();
+      std::vector<Atom> atoms;
+      for (std::uint32_t j = 0; j < atoms_count; ++j) {
+        const bool negative = reader.Get<std::uint8_t>();
+        std::string predicate{reader.GetSymbol()};
+        atoms.emplace_back(negative, std::move(predicate), reader.GetTerms());
+      }
+      cached.clauses.emplace_back(std::move(atoms));
+    }
+
+    if (!reader.done()) {
+      return std::nullopt;
+    }
+    return cached;
+  } catch (const InvalidImage&) {
+    return std::nullopt;
+  }
+}
+
+std::optional<CachedClauses> ClauseCache::Load(std::uint64_t key) const {
+  std::optional<details::utils::MappedFile> file;
+  try {
+    file.emplace(Path(key));
+  } catch (const std::system_error&) {
+    return std::nullopt;
+  }
+  return Deserialize(file->view(), key, version_);
+}
+
+void ClauseCache::Store(std::uint64_t key, const CachedClauses& cached) const {
+  std::filesystem::create_directories(directory_);
+  auto path = Path(key);
+  auto temporary = path + "." + std::to_string(::getpid());
+  {
+    std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+    auto image = Serialize(key, version_, cached);
+    if (!out.write(image.data(), image.size()).flush()) {
+      throw std::system_error{errno, std::generic_category(), temporary};
+    }
+  }
+  std::filesystem::rename(temporary, path);
+}
+
+std::string ClauseCache::Path(std::uint64_t key) const {
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx",
+                static_cast<unsigned long long>(key));
+  return (std::filesystem::path{directory_} / name).string() + ".clauses";
+}
+}  // namespace fol::types
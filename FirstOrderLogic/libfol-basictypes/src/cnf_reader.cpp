@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <libfol-basictypes/cnf_reader.hpp>
+#include <libfol-parser/lexer/tokenizer.hpp>
+#include <libfol-transform/normalization_context.hpp>
+#include <system_error>
+#include <unordered_map>
+
+namespace fol::types {
+namespace {
+using Position = std::string_view::size_type;
+using lexer::TokenKind;
+
+std::string_view Trim(std::string_view str) {
+  auto begin = details::utils::SkipWhiteSpaces(0, str);
+  auto end = str.size();
+  while (end > begin && std::isspace(str[end - 1])) {
+    --end;
+  }
+  return str.substr(begin, end - begin);
+}
+
+// Offset in the clause text and the message
+struct ClauseError {
+  Position position;
+  std::string what;
+};
+
+// Recursive descent over the tokens of one clause. Variables are mapped to
+// fresh names of the current normalization context.
+class ClauseParser {
+ public:
+  explicit ClauseParser(std::string_view text) : tokenizer_(text) {}
+
+  Clause Parse() {
+    Advance();
+    const bool bracketed = Accept(TokenKind::OPEN_BRACKET);
+    std::vector<Atom> atoms;
+    atoms.push_back(Literal());
+    while (Accept(TokenKind::OR)) {
+      atoms.push_back(Literal());
+    }
+    if (bracketed) {
+      Expect(TokenKind::CLOSE_BRACKET, "expected ')'");
+    }
+    Expect(TokenKind::EPS, "expected or, | or the end of the clause");
+    return Clause{std::move(atoms)};
+  }
+
+  Position position() const { return tokenizer_.position(); }
+
+ private:
+  Atom Literal() {
+    const bool negative = Accept(TokenKind::NOT);
+    if (token_.kind != TokenKind::PREDICATE) {
+      Fail("expected a predicate");
+    }
+    std::string name{tokenizer_.Text(token_)};
+    Advance();
+    return Atom{negative, std::move(name), Arguments()};
+  }
+
+  std::vector<Term> Arguments() {
+    Expect(TokenKind::OPEN_BRACKET, "expected '('");
+    std::vector<Term> args;
+    do {
+      args.push_back(ParseTerm());
+    } while (Accept(TokenKind::COMMA));
+    Expect(TokenKind::CLOSE_BRACKET, "expected ')'");
+    return args;
+  }
+
+  Term ParseTerm() {
+    auto text = tokenizer_.Text(token_);
+    switch (token_.kind) {
+      case TokenKind::CONSTANT:
+        Advance();
+        return {lexer::Constant{text}};
+      case TokenKind::VARIABLE:
+        Advance();
+        return {lexer::Variable{std::string_view{Rename(text)}}};
+      case TokenKind::FUNCTION:
+        Advance();
+        return {lexer::Function{text} * parser::ToTermList(Arguments())};
+      default:
+        Fail("expected a term");
+    }
+  }
+
+  const std::string& Rename(std::string_view var) {
+    auto [it, inserted] = renaming_.try_emplace(std::string{var});
+    if (inserted) {
+      it->second = transform::NormalizationContext::Current().FreshVar();
+    }
+    return it->second;
+  }
+
+  void Advance() { token_ = tokenizer_.Next(); }
+
+  bool Accept(TokenKind kind) {
+    if (token_.kind != kind) {
+      return false;
+    }
+    Advance();
+    return true;
+  }
+
+  void Expect(TokenKind kind, const std::string& what) {
+    if (!Accept(kind)) {
+      Fail(what);
+    }
+  }
+
+  [[noreturn]] void Fail(const std::string& what) const {
+    throw ClauseError{token_.span.begin, what};
+  }
+
+  lexer::Tokenizer tokenizer_;
+  lexer::Token token_;
+  std::unordered_map<std::string, std::string> renaming_;
+};
+}  // namespace
+
+CnfReader::CnfReader(const std::string& path) : name_(path) {
+  try {
+    file_.emplace(path);
+  } catch (const std::system_error& e) {
+    throw parser::ProblemError{e.what()};
+  }
+  source_ = file_->view();
+}
+
+CnfReader::CnfReader(std::string name, std::string source)
+    : name_(std::move(name)), buffer_(std::move(source)), source_(buffer_) {}
+
+CnfProblem CnfReader::Read() {
+  CnfProblem problem;
+  auto position = details::utils::SkipWhiteSpaces(0, source_);
+  while (position < source_.size() && source_[position] == '%') {
+    position = details::utils::SkipWhiteSpaces(
+        std::min(source_.find('\n', position), source_.size()), source_);
+  }
+
+  if (source_.substr(position).starts_with("cnf")) {
+    ReadStatements(problem);
+  } else {
+    ReadLines(problem);
+  }
+  return problem;
+}
+
+void CnfReader::ReadStatements(CnfProblem& problem) {
+  Position position = 0;
+  // text up to the next comma, trimmed
+  auto field = [&](Position begin) {
+    auto end = source_.find(',', begin);
+    if (end == std::string_view::npos) {
+      Fail(begin, "expected ','");
+    }
+    position = end + 1;
+    auto text = Trim(source_.substr(begin, end - begin));
+    if (text.empty()) {
+      Fail(begin, "expected a name");
+    }
+    return text;
+  };
+
+  while ((position = details::utils::SkipWhiteSpaces(position, source_)) <
+         source_.size()) {
+    if (source_[position] == '%') {
+      position = std::min(source_.find('\n', position), source_.size());
+      continue;
+    }
+
+    auto statement = source_.substr(position);
+    if (!statement.starts_with("cnf")) {
+      Fail(position, "expected cnf(");
+    }
+    position = details::utils::SkipWhiteSpaces(position + 3, source_);
+    if (position == source_.size() || source_[position] != '(') {
+      Fail(position, "expected '('");
+    }
+
+    field(position + 1);
+    const auto role = field(position);
+
+    const auto begin = position;
+    for (int depth = 1; depth > 0; ++position) {
+      if (position == source_.size()) {
+        Fail(begin, "unbalanced brackets");
+      }
+      depth += source_[position] == '(';
+      depth -= source_[position] == ')';
+    }
+    const auto end = position - 1;
+
+    position = details::utils::SkipWhiteSpaces(position, source_);
+    if (position == source_.size() || source_[position] != '.') {
+      Fail(position, "expected '.'");
+    }
+    ++position;
+
+    auto& clauses =
+        role == "negated_conjecture" ? problem.hypothesis : problem.axioms;
+    clauses.push_back(ParseClause(begin, end));
+  }
+}
+
+void CnfReader::ReadLines(CnfProblem& problem) {
+  std::size_t axioms_count = 0;
+  bool counted = false;
+  Position position = 0;
+  while (position < source_.size()) {
+    auto end = std::min(source_.find('\n', position), source_.size());
+    auto line = Trim(source_.substr(position, end - position));
+    const auto begin = static_cast<Position>(line.data() - source_.data());
+    position = end + 1;
+    if (line.empty() || line.front() == '%') {
+      continue;
+    }
+
+    if (!counted) {
+      auto [last, error] = std::from_chars(
+          line.data(), line.data() + line.size(), axioms_count);
+      if (error != std::errc{} || last != line.data() + line.size()) {
+        Fail(begin, "expected the number of axiom clauses");
+      }
+      counted = true;
+      continue;
+    }
+
+    auto& clauses = problem.axioms.size() < axioms_count ? problem.axioms
+                                                         : problem.hypothesis;
+    clauses.push_back(ParseClause(begin, begin + line.size()));
+  }
+
+  if (!counted) {
+    Fail(source_.size(), "expected the number of axiom clauses");
+  }
+  if (problem.axioms.size() < axioms_count) {
+    Fail(source_.size(), "expected " + std::to_string(axioms_count) +
+                             " axiom clauses, found " +
+                             std::to_string(problem.axioms.size()));
+  }
+}
+
+Clause CnfReader::ParseClause(Position begin, Position end) const {
+  ClauseParser parser{source_.substr(begin, end - begin)};
+  try {
+    return parser.Parse();
+  } catch (const ClauseError& e) {
+    Fail(begin + e.position, e.what);
+  } catch (const lexer::LexerError& e) {
+    Fail(begin + parser.position(), e.what());
+  }
+}
+
+void CnfReader::Fail(Position position, const std::string& what) const {
+  auto before = source_.substr(0, std::min(position, source_.size()));
+  auto line_begin = before.rfind('\n');
+  auto column = line_begin == std::string_view::npos
+                    ? before.size() + 1
+                    : before.size() - line_begin;
+  auto line = 1 + std::count(before.begin(), before.end(), '\n');
+  throw parser::ProblemError{name_ + ":" + std::to_string(line) + ":" +
+                             std::to_string(column) + ": " + what};
+}
+}  // namespace fol::types
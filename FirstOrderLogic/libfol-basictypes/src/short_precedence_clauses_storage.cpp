@@ -20,15 +20,13 @@ bool ShortPrecedenceClausesStorage::empty() const { return storage_.empty(); }
 
 std::vector<Clause> ShortPrecedenceClausesStorage::Infer(
     const Clause& c, const unification::IUnificator& unificator) const {
-  std::vector<Clause> res;
+  std::vector<const Clause*> clauses;
+  clauses.reserve(storage_.size());
 
   for (auto& c_s : storage_) {
-    auto o_c = unificator.Resolution(c, c_s);
-    if (o_c) {
-      res.push_back(*o_c);
-    }
+    clauses.push_back(&c_s);
   }
 
-  return res;
+  return unificator.Resolutions(c, clauses);
 }
 }  // namespace fol::types
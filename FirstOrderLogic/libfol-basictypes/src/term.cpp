@@ -9,19 +9,21 @@ Term Clone(const Term& t) { return transform::CloneTerm(t); }
 bool Contains(const parser::FunctionFormula& function, const Term& var) {
   for (auto it = parser::FunctionTermsIt(function);
        it != parser::ConstTermListIt{}; ++it) {
-    if (*it == var) {
+    if (Contains(*it, var)) {
       return true;
-    } else if (it->IsFunction()) {
-      return Contains(it->Function(), var);
     }
   }
 
   return false;
 }
 bool Contains(const Term& term, const Term& var) {
+  if (var.IsVar() && (term.info().ground ||
+                      (term.info().vars & parser::VarBit(var.Var())) == 0)) {
+    return false;
+  }
   if (!term.IsFunction()) {
     return term == var;
   }
-  return Contains(term.Function(), var);
+  return term == var || Contains(term.Function(), var);
 }
 }  // namespace fol::types
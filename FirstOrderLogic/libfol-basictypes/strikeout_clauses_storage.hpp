@@ -21,9 +21,14 @@ class StrikeoutClausesStorage : public IClausesStorage {
                           std::unique_ptr<unification::IUnificator> unifier)
       : unifier_(std::move(unifier)) {
     for (auto& c : s) {
-      if (!Contains(c) && !unifier_->IsTautology(c)) {
-        storage_.AddClause(c);
-      }
+      AddInputClause(c);
+    }
+  }
+
+  // Input clauses are not checked against the ones they may be part of
+  void AddInputClause(const Clause& c) {
+    if (!Contains(c) && !unifier_->IsTautology(c)) {
+      storage_.AddClause(c);
     }
   }
 
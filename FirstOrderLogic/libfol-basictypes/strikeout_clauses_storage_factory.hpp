@@ -11,16 +11,21 @@ class StrikeoutClausesStorageFactory : public IClausesStorageFactory {
   StrikeoutClausesStorageFactory(
       std::shared_ptr<unification::IUnificatorFactory> unifier)
       : unifier_factory_(std::move(unifier)) {}
-  std::pair<std::unique_ptr<IClausesStorage>, std::unique_ptr<IClausesStorage>>
-  create(std::vector<Clause> axioms, std::vector<Clause> hypothesis) override {
-    axioms.reserve(axioms.size() + hypothesis.size());
-    axioms.insert(axioms.end(), hypothesis.begin(), hypothesis.end());
+
+  using IClausesStorageFactory::create;
+
+  Storages create() override {
     return {std::make_unique<StrikeoutClausesStorage<T>>(
-                std::move(axioms), unifier_factory_->create()),
+                unifier_factory_->create()),
             std::make_unique<StrikeoutClausesStorage<T>>(
                 unifier_factory_->create())};
   }
 
+  void Insert(Storages& storages, const Clause& clause, bool) override {
+    static_cast<StrikeoutClausesStorage<T>&>(*storages.first)
+        .AddInputClause(clause);
+  }
+
  private:
   std::shared_ptr<unification::IUnificatorFactory> unifier_factory_;
 };
@@ -6,10 +6,15 @@ namespace fol::types {
 template <class T>
 class SupportClausesStorageFactory : public T, public IClausesStorageFactory {
  public:
-  std::pair<std::unique_ptr<IClausesStorage>, std::unique_ptr<IClausesStorage>>
-  create(std::vector<Clause> axioms, std::vector<Clause> hypothesis) override {
-    return {std::make_unique<T>(std::move(hypothesis)),
-            std::make_unique<T>(std::move(axioms))};
+  using IClausesStorageFactory::create;
+
+  Storages create() override {
+    return {std::make_unique<T>(), std::make_unique<T>()};
+  }
+
+  void Insert(Storages& storages, const Clause& clause,
+              bool hypothesis) override {
+    (hypothesis ? storages.first : storages.second)->AddClause(clause);
   }
 };
 }  // namespace fol::types
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <libfol-matcher/view_matcher.hpp>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Rewrite rules compiled into a dispatch table. A node is classified once by
+// its kind and, for a negation, the kind of its operand; only the rules whose
+// pattern may match that shape are tried, first one that matches fires.
+namespace fol::matcher::view {
+template <typename Pattern, typename Action>
+struct Rule {
+  using PatternType = Pattern;
+  using ActionType = Action;
+
+  Pattern pattern;
+  Action action;
+};
+
+// action is called without arguments after pattern matched, it reads the
+// views the pattern bound
+template <typename Pattern, typename Action>
+inline Rule<Pattern, Action> On(Pattern pattern, Action action) {
+  return {std::move(pattern), std::move(action)};
+}
+
+inline constexpr std::size_t kShapes = kNodeKinds * kNodeKinds;
+
+template <bool Const>
+std::size_t Shape(BasicFormulaView<Const> o) {
+  auto kind = Classify(o);
+  if (kind != NOT) {
+    return kind * kNodeKinds;
+  }
+  auto &not_formula = std::get<parser::NotFormula>(o.AsUnaryInBrackets()->data);
+  return kind * kNodeKinds +
+         Classify(BasicFormulaView<Const>{not_formula.data.get()});
+}
+
+template <typename... Rules>
+class RuleSet {
+  static_assert(sizeof...(Rules) <= 32, "rule bitmask is 32 bits");
+
+ public:
+  using Result = std::common_type_t<
+      std::invoke_result_t<const typename Rules::ActionType &>...>;
+
+  explicit RuleSet(Rules... rules) : rules_(std::move(rules)...) {}
+
+  // Result of the first rule that matches, nullopt if none
+  template <bool Const>
+  std::optional<Result> Apply(BasicFormulaView<Const> o) const {
+    return Apply(o, kDispatch[Shape(o)],
+                 std::index_sequence_for<Rules...>{});
+  }
+
+  // Rules that may match a node of the shape, bit i for the i-th rule
+  static constexpr std::uint32_t Candidates(std::size_t shape) {
+    return kDispatch[shape];
+  }
+
+ private:
+  template <bool Const, std::size_t... I>
+  std::optional<Result> Apply(BasicFormulaView<Const> o,
+                              std::uint32_t candidates,
+                              std::index_sequence<I...>) const {
+    std::optional<Result> res;
+    (((candidates >> I & 1) && std::get<I>(rules_).pattern.match(o) &&
+      (res.emplace(std::get<I>(rules_).action()), true)) ||
+     ...);
+    return res;
+  }
+
+  template <typename Pattern>
+  static constexpr void Add(std::array<std::uint32_t, kShapes> &dispatch,
+                            std::uint32_t bit) {
+    for (std::size_t kind = 0; kind < kNodeKinds; ++kind) {
+      if (!(Pattern::kKinds >> kind & 1)) {
+        continue;
+      }
+      for (std::size_t operand = 0; operand < kNodeKinds; ++operand) {
+        if (kind != NOT || Pattern::kOperandKinds >> operand & 1) {
+          dispatch[kind * kNodeKinds + operand] |= bit;
+        }
+      }
+    }
+  }
+
+  static constexpr std::array<std::uint32_t, kShapes> kDispatch = [] {
+    std::array<std::uint32_t, kShapes> dispatch{};
+    std::uint32_t bit = 1;
+    ((Add<typename Rules::PatternType>(dispatch, bit), bit <<= 1), ...);
+    return dispatch;
+  }();
+
+  std::tuple<Rules...> rules_;
+};
+}  // namespace fol::matcher::view
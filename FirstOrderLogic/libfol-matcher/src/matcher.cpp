@@ -177,11 +177,11 @@ bool VariableMatcher::match(parser::TermList o) {
     return false;
   }
 
-  if (!std::holds_alternative<lexer::Variable>(matcher.term->data)) {
+  if (!matcher.term->IsVar()) {
     return false;
   }
 
-  formula = std::get<lexer::Variable>(std::move(matcher.term->data));
+  formula = std::move(*matcher.term).Var();
   return true;
 }
 
@@ -191,11 +191,11 @@ bool FunctionMatcher::match(parser::TermList o) {
     return false;
   }
 
-  if (!std::holds_alternative<parser::FunctionFormula>(matcher.term->data)) {
+  if (!matcher.term->IsFunction()) {
     return false;
   }
 
-  function = std::get<parser::FunctionFormula>(std::move(matcher.term->data));
+  function = std::move(*matcher.term).Function();
   return true;
 }
 
@@ -205,11 +205,11 @@ bool ConstantMatcher::match(parser::TermList o) {
     return false;
   }
 
-  if (!std::holds_alternative<lexer::Constant>(matcher.term->data)) {
+  if (!matcher.term->IsConstant()) {
     return false;
   }
 
-  constant = std::get<lexer::Constant>(std::move(matcher.term->data));
+  constant = std::move(*matcher.term).Const();
   return true;
 }
 
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <libfol-parser/parser/types.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Matchers that bind views of the subformulas instead of moving them out.
+// A failed match leaves the formula untouched, a rewrite that fires takes the
+// parts it needs out of the bound views.
+namespace fol::matcher::view {
+// Non-owning view of a formula, of a disjunction or conjunction from one of
+// its items on, or of a unary formula. Const views only read the formula.
+template <bool Const>
+class BasicFormulaView {
+  template <typename T>
+  using Ptr = std::conditional_t<Const, const T *, T *>;
+
+ public:
+  using ImplPair =
+      std::pair<parser::DisjunctionFormula, parser::ImplicationFormula>;
+  using DisjTail =
+      std::pair<parser::ConjunctionFormula, parser::DisjunctionPrimeFormula>;
+  using ConjTail =
+      std::pair<parser::UnaryFormula, parser::ConjunctionPrimeFormula>;
+
+  BasicFormulaView(Ptr<parser::ImplicationFormula> formula) : data_(formula) {}
+  BasicFormulaView(Ptr<DisjTail> disj) : data_(disj) {}
+  BasicFormulaView(Ptr<ConjTail> conj) : data_(conj) {}
+  BasicFormulaView(Ptr<parser::UnaryFormula> unary) : data_(unary) {}
+
+  // Both sides of an implication
+  Ptr<ImplPair> AsImpl() const {
+    if (auto impl = std::get_if<Ptr<parser::ImplicationFormula>>(&data_)) {
+      if (auto pair = std::get_if<1>(&(*impl)->data)) {
+        return pair->get();
+      }
+    }
+    return nullptr;
+  }
+
+  // Disjuncts, the last one with an EPS tail
+  Ptr<DisjTail> AsDisj() const {
+    if (auto impl = std::get_if<Ptr<parser::ImplicationFormula>>(&data_)) {
+      if (auto disj = std::get_if<parser::DisjunctionFormula>(&(*impl)->data)) {
+        return &disj->data;
+      }
+      return nullptr;
+    }
+    if (auto disj = std::get_if<Ptr<DisjTail>>(&data_)) {
+      return *disj;
+    }
+    return nullptr;
+  }
+
+  // Conjuncts of a single disjunct
+  Ptr<ConjTail> AsConj() const {
+    if (auto conj = std::get_if<Ptr<ConjTail>>(&data_)) {
+      return *conj;
+    }
+    auto disj = AsDisj();
+    if (!disj || !std::holds_alternative<lexer::EPS>(disj->second.data)) {
+      return nullptr;
+    }
+    return disj->first.data.get();
+  }
+
+  // The single unary formula, brackets around it kept
+  Ptr<parser::UnaryFormula> AsUnary() const {
+    if (auto unary = std::get_if<Ptr<parser::UnaryFormula>>(&data_)) {
+      return *unary;
+    }
+    auto conj = AsConj();
+    if (!conj || !std::holds_alternative<lexer::EPS>(conj->second.data)) {
+      return nullptr;
+    }
+    return &conj->first;
+  }
+
+  // View of the formula inside all the brackets around it
+  BasicFormulaView SkipBrackets() const {
+    auto res = *this;
+    while (auto unary = res.AsUnary()) {
+      auto bracket = std::get_if<parser::BracketFormula>(&unary->data);
+      if (!bracket) {
+        break;
+      }
+      res = BasicFormulaView{&bracket->data};
+    }
+    return res;
+  }
+
+  // The single unary formula inside the brackets around it
+  Ptr<parser::UnaryFormula> AsUnaryInBrackets() const {
+    return SkipBrackets().AsUnary();
+  }
+
+  // Moves the viewed part out, the formula it belongs to is left moved from
+  parser::FolFormula Take() const
+    requires(!Const)
+  {
+    return std::visit(
+        [](auto ptr) -> parser::FolFormula {
+          using T = std::remove_pointer_t<decltype(ptr)>;
+          if constexpr (std::is_same_v<T, parser::ImplicationFormula>) {
+            return std::move(*ptr);
+          } else if constexpr (std::is_same_v<T, DisjTail>) {
+            return parser::ToFol(parser::DisjunctionFormula{std::move(*ptr)});
+          } else if constexpr (std::is_same_v<T, ConjTail>) {
+            return parser::ToFol(parser::ConjunctionFormula{
+                std::make_unique<ConjTail>(std::move(*ptr))});
+          } else {
+            return parser::ToFol(std::move(*ptr));
+          }
+        },
+        data_);
+  }
+
+ private:
+  std::variant<Ptr<parser::ImplicationFormula>, Ptr<DisjTail>, Ptr<ConjTail>,
+               Ptr<parser::UnaryFormula>>
+      data_;
+};
+
+using FormulaView = BasicFormulaView<false>;
+using ConstFormulaView = BasicFormulaView<true>;
+
+// Kind of the node inside the brackets, what the matchers dispatch on
+enum NodeKind : std::uint8_t { IMPL, DISJ, CONJ, NOT, FORALL, EXISTS, PRED };
+
+inline constexpr std::size_t kNodeKinds = PRED + 1;
+
+// Set of node kinds, bit k for kind k
+using KindMask = std::uint8_t;
+
+inline constexpr KindMask kAnyKind = (1 << kNodeKinds) - 1;
+
+constexpr KindMask Kinds(NodeKind kind) { return 1 << kind; }
+
+template <bool Const>
+NodeKind Classify(BasicFormulaView<Const> o) {
+  o = o.SkipBrackets();
+  if (o.AsImpl()) {
+    return IMPL;
+  }
+  if (auto disj = o.AsDisj();
+      disj && !std::holds_alternative<lexer::EPS>(disj->second.data)) {
+    return DISJ;
+  }
+  if (auto unary = o.AsUnary()) {
+    switch (unary->data.index()) {
+      case 1:
+        return NOT;
+      case 2:
+        return FORALL;
+      case 3:
+        return EXISTS;
+      case 4:
+        return PRED;
+    }
+  }
+  return CONJ;
+}
+
+// Every matcher tells the kinds of the nodes it may match and, for a
+// negation, the kinds of its operand
+struct AnythingMatcher {
+  static constexpr KindMask kKinds = kAnyKind;
+  static constexpr KindMask kOperandKinds = kAnyKind;
+
+  template <bool Const>
+  bool match(BasicFormulaView<Const>) const {
+    return true;
+  }
+};
+
+template <typename T>
+struct BindMatcher {
+  static constexpr KindMask kKinds = kAnyKind;
+  static constexpr KindMask kOperandKinds = kAnyKind;
+
+  bool match(const T &t) const {
+    out.get() = t;
+    return true;
+  }
+
+  std::reference_wrapper<std::optional<T>> out;
+};
+
+template <typename FMatcher, typename SMatcher>
+struct ImplicationMatcher {
+  static constexpr KindMask kKinds = Kinds(IMPL);
+  static constexpr KindMask kOperandKinds = kAnyKind;
+
+  template <bool Const>
+  bool match(BasicFormulaView<Const> o) const {
+    auto pair = o.AsImpl();
+    return pair && first.match(BasicFormulaView<Const>{&pair->first.data}) &&
+           second.match(BasicFormulaView<Const>{&pair->second});
+  }
+
+  FMatcher first;
+  SMatcher second;
+};
+
+// The first disjunct and the rest, brackets around skipped
+template <typename FMatcher, typename SMatcher>
+struct DisjunctionMatcher {
+  static constexpr KindMask kKinds = Kinds(DISJ);
+  static constexpr KindMask kOperandKinds = kAnyKind;
+
+  template <bool Const>
+  bool match(BasicFormulaView<Const> o) const {
+    auto disj = o.SkipBrackets().AsDisj();
+    if (!disj || std::holds_alternative<lexer::EPS>(disj->second.data)) {
+      return false;
+    }
+    return first.match(BasicFormulaView<Const>{disj->first.data.get()}) &&
+           second.match(
+               BasicFormulaView<Const>{std::get<0>(disj->second.data).get()});
+  }
+
+  FMatcher first;
+  SMatcher second;
+};
+
+// The first conjunct and the rest, brackets around skipped
+template <typename FMatcher, typename SMatcher>
+struct ConjunctionMatcher {
+  static constexpr KindMask kKinds = Kinds(CONJ);
+  static constexpr KindMask kOperandKinds = kAnyKind;
+
+  template <bool Const>
+  bool match(BasicFormulaView<Const> o) const {
+    auto conj = o.SkipBrackets().AsConj();
+    if (!conj || std::holds_alternative<lexer::EPS>(conj->second.data)) {
+      return false;
+    }
+    return first.match(BasicFormulaView<Const>{&conj->first}) &&
+           second.match(
+               BasicFormulaView<Const>{std::get<0>(conj->second.data).get()});
+  }
+
+  FMatcher first;
+  SMatcher second;
+};
+
+template <typename Matcher>
+struct NotMatcher {
+  static constexpr KindMask kKinds = Kinds(NOT);
+  static constexpr KindMask kOperandKinds = Matcher::kKinds;
+
+  template <bool Const>
+  bool match(BasicFormulaView<Const> o) const {
+    auto unary = o.AsUnaryInBrackets();
+    if (!unary) {
+      return false;
+    }
+    auto not_formula = std::get_if<parser::NotFormula>(&unary->data);
+    return not_formula &&
+           matcher.match(BasicFormulaView<Const>{not_formula->data.get()});
+  }
+
+  Matcher matcher;
+};
+
+template <typename Quantifier, typename NameMatcher, typename ImplMatcher>
+struct QuantifierMatcher {
+  static constexpr KindMask kKinds =
+      Kinds(std::is_same_v<Quantifier, parser::ForallFormula> ? FORALL
+                                                              : EXISTS);
+  static constexpr KindMask kOperandKinds = kAnyKind;
+
+  template <bool Const>
+  bool match(BasicFormulaView<Const> o) const {
+    auto unary = o.AsUnaryInBrackets();
+    if (!unary) {
+      return false;
+    }
+    auto quantifier = std::get_if<Quantifier>(&unary->data);
+    return quantifier && var.match(quantifier->data.first) &&
+           matcher.match(BasicFormulaView<Const>{&quantifier->data.second});
+  }
+
+  NameMatcher var;
+  ImplMatcher matcher;
+};
+
+template <typename NameMatcher, typename ImplMatcher>
+using ForallMatcher =
+    QuantifierMatcher<parser::ForallFormula, NameMatcher, ImplMatcher>;
+
+template <typename NameMatcher, typename ImplMatcher>
+using ExistsMatcher =
+    QuantifierMatcher<parser::ExistsFormula, NameMatcher, ImplMatcher>;
+
+struct AnyNameMatcher {
+  bool match(const std::string &) const { return true; }
+};
+
+inline AnythingMatcher Anything() { return {}; }
+
+template <typename T>
+inline BindMatcher<T> Bind(std::optional<T> &out) {
+  return {out};
+}
+
+template <typename FMatcher, typename SMatcher>
+inline ImplicationMatcher<FMatcher, SMatcher> Impl(FMatcher lhs,
+                                                   SMatcher rhs) {
+  return {std::move(lhs), std::move(rhs)};
+}
+
+template <typename FMatcher, typename SMatcher>
+inline DisjunctionMatcher<FMatcher, SMatcher> Disj(FMatcher lhs,
+                                                   SMatcher rhs) {
+  return {std::move(lhs), std::move(rhs)};
+}
+
+template <typename FMatcher, typename SMatcher>
+inline ConjunctionMatcher<FMatcher, SMatcher> Conj(FMatcher lhs,
+                                                   SMatcher rhs) {
+  return {std::move(lhs), std::move(rhs)};
+}
+
+template <typename T>
+inline NotMatcher<T> Not(T matcher) {
+  return {std::move(matcher)};
+}
+
+template <typename NameMatcher, typename T>
+inline ForallMatcher<NameMatcher, T> Forall(NameMatcher var, T matcher) {
+  return {std::move(var), std::move(matcher)};
+}
+
+template <typename T>
+inline ForallMatcher<AnyNameMatcher, T> Forall(T matcher) {
+  return {{}, std::move(matcher)};
+}
+
+template <typename NameMatcher, typename T>
+inline ExistsMatcher<NameMatcher, T> Exists(NameMatcher var, T matcher) {
+  return {std::move(var), std::move(matcher)};
+}
+
+template <typename T>
+inline ExistsMatcher<AnyNameMatcher, T> Exists(T matcher) {
+  return {{}, std::move(matcher)};
+}
+}  // namespace fol::matcher::view
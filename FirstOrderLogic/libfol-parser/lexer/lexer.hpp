@@ -5,6 +5,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <variant>
 
@@ -71,9 +72,14 @@ struct LexerError : std::runtime_error {
   using std::runtime_error::runtime_error;
 };
 
-inline std::string::size_type i = 0;
+// Position after the last lexeme yielded by Tokenize on this thread, or of the
+// offending character after a LexerError
+inline thread_local std::string::size_type i = 0;
 
 LexemeGenerator Tokenize(std::string string);
 
+// Tokenize over a source that outlives the generator
+LexemeGenerator TokenizeView(std::string_view source);
+
 }  // namespace fol::lexer
 
@@ -1,4 +1,5 @@
 #include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/lexer/tokenizer.hpp>
 
 namespace fol::lexer {
 inline namespace literals {
@@ -48,80 +49,24 @@ std::ostream &operator<<(std::ostream &os, const Lexeme &lexeme) {
 }
 
 LexemeGenerator Tokenize(std::string string) {
-  i = 0;
-  while (i < string.size()) {
-    i = details::utils::SkipWhiteSpaces(i, string);
-    if (i >= string.size()) {
-      break;
-    }
-    switch (string[i]) {
-      case 'v':
-        co_yield Variable{details::utils::GetUntilWhiteSpace(i, string)};
-        break;
-      case 'c':
-        co_yield Constant{details::utils::GetUntilWhiteSpace(i, string)};
-        break;
-      case 'f':
-        co_yield Function{details::utils::GetUntilWhiteSpace(i, string)};
-        break;
-      case 'p':
-        co_yield Predicate{details::utils::GetUntilWhiteSpace(i, string)};
-        break;
-      case '@':
-        co_yield Forall{};
-        ++i;
-        break;
-      case '?':
-        co_yield Exists{};
-        ++i;
-        break;
-      case '(':
-        co_yield OpenBracket{};
-        ++i;
-        break;
-      case ')':
-        co_yield CloseBracket{};
-        ++i;
-        break;
-      case 'a':  // and
-        if (string[i + 1] != 'n' || string[i + 2] != 'd') {
-          throw LexerError{"Error in tokenizing"};
-        }
-        co_yield And{};
-        i += 3;
-        break;
-      case '~':
-        co_yield Not{};
-        ++i;
-        break;
-      case '-':  // ->
-        if (string[i + 1] != '>') {
-          throw LexerError{"Error in tokenizing"};
-        }
-        co_yield Implies{};
-        i += 2;
-        break;
-      case ',':
-        co_yield Comma{};
-        ++i;
-        break;
-      case '.':
-        co_yield Dot{};
-        ++i;
-        break;
-      case 'o':  // or
-        if (string[i + 1] != 'r') {
-          throw LexerError{"Error in tokenizing"};
-        }
-        co_yield Or{};
-        i += 2;
-        break;
-      default:
-        throw LexerError{std::string{"Unhandled lexem: \'"} + string[i] + "'"};
-    }
+  for (auto &lexeme : TokenizeView(string)) {
+    co_yield lexeme;
   }
+}
+
+LexemeGenerator TokenizeView(std::string_view source) {
+  Tokenizer tokenizer{source};
+  i = 0;
   for (;;) {
-    co_yield EPS{};
+    Token token;
+    try {
+      token = tokenizer.Next();
+    } catch (const LexerError &) {
+      i = tokenizer.position();
+      throw;
+    }
+    i = tokenizer.position();
+    co_yield ToLexeme(token, tokenizer.Text(token));
   }
 }
 
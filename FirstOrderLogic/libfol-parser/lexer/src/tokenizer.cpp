@@ -0,0 +1,155 @@
+#include <array>
+#include <libfol-parser/lexer/tokenizer.hpp>
+
+namespace fol::lexer {
+namespace {
+constexpr std::array<bool, 256> MakeDelimiters() {
+  std::array<bool, 256> res{};
+  for (unsigned char c : std::string_view{" \t\n\v\f\r(),.?@~-|"}) {
+    res[c] = true;
+  }
+  return res;
+}
+
+constexpr auto kDelimiters = MakeDelimiters();
+
+bool IsDelimiter(char c) {
+  return kDelimiters[static_cast<unsigned char>(c)];
+}
+
+bool IsSpace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+}  // namespace
+
+SymbolId SymbolTable::Intern(std::string_view name) {
+  if (auto it = ids_.find(name); it != ids_.end()) {
+    return it->second;
+  }
+  auto id = static_cast<SymbolId>(names_.size());
+  names_.emplace_back(name);
+  ids_.emplace(names_.back(), id);
+  return id;
+}
+
+std::optional<SymbolId> SymbolTable::Find(std::string_view name) const {
+  if (auto it = ids_.find(name); it != ids_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+Token Tokenizer::Symbol(TokenKind kind) {
+  auto begin = position_;
+  while (position_ < source_.size() && !IsDelimiter(source_[position_])) {
+    ++position_;
+  }
+
+  Token token{kind, {begin, position_}};
+  if (symbols_) {
+    token.symbol = symbols_->Intern(Text(token));
+  }
+  return token;
+}
+
+Token Tokenizer::Punctuation(TokenKind kind, std::size_t length) {
+  Token token{kind, {position_, position_ + length}};
+  position_ += length;
+  return token;
+}
+
+Token Tokenizer::Next() {
+  while (position_ < source_.size() && IsSpace(source_[position_])) {
+    ++position_;
+  }
+  if (position_ >= source_.size()) {
+    return Token{TokenKind::EPS, {position_, position_}};
+  }
+
+  auto rest = source_.substr(position_);
+  switch (rest.front()) {
+    case 'v':
+      return Symbol(TokenKind::VARIABLE);
+    case 'c':
+      return Symbol(TokenKind::CONSTANT);
+    case 'f':
+      return Symbol(TokenKind::FUNCTION);
+    case 'p':
+      return Symbol(TokenKind::PREDICATE);
+    case '@':
+      return Punctuation(TokenKind::FORALL, 1);
+    case '?':
+      return Punctuation(TokenKind::EXISTS, 1);
+    case '(':
+      return Punctuation(TokenKind::OPEN_BRACKET, 1);
+    case ')':
+      return Punctuation(TokenKind::CLOSE_BRACKET, 1);
+    case 'a':  // and
+      if (!rest.starts_with("and")) {
+        throw LexerError{"Error in tokenizing"};
+      }
+      return Punctuation(TokenKind::AND, 3);
+    case '~':
+      return Punctuation(TokenKind::NOT, 1);
+    case '-':  // ->
+      if (!rest.starts_with("->")) {
+        throw LexerError{"Error in tokenizing"};
+      }
+      return Punctuation(TokenKind::IMPLIES, 2);
+    case ',':
+      return Punctuation(TokenKind::COMMA, 1);
+    case '.':
+      return Punctuation(TokenKind::DOT, 1);
+    case 'o':  // or
+      if (!rest.starts_with("or")) {
+        throw LexerError{"Error in tokenizing"};
+      }
+      return Punctuation(TokenKind::OR, 2);
+    case '|':
+      return Punctuation(TokenKind::OR, 1);
+    default:
+      throw LexerError{std::string{"Unhandled lexem: \'"} + rest.front() +
+                       "'"};
+  }
+}
+
+Lexeme ToLexeme(const Token &token, std::string_view text) {
+  switch (token.kind) {
+    case TokenKind::EPS:
+      return EPS{};
+    case TokenKind::OPEN_BRACKET:
+      return OpenBracket{};
+    case TokenKind::CLOSE_BRACKET:
+      return CloseBracket{};
+    case TokenKind::FORALL:
+      return Forall{};
+    case TokenKind::EXISTS:
+      return Exists{};
+    case TokenKind::AND:
+      return And{};
+    case TokenKind::OR:
+      return Or{};
+    case TokenKind::IMPLIES:
+      return Implies{};
+    case TokenKind::NOT:
+      return Not{};
+    case TokenKind::COMMA:
+      return Comma{};
+    case TokenKind::DOT:
+      return Dot{};
+    case TokenKind::FUNCTION:
+      return Function{text};
+    case TokenKind::VARIABLE:
+      return Variable{text};
+    case TokenKind::PREDICATE:
+      return Predicate{text};
+    case TokenKind::CONSTANT:
+      return Constant{text};
+  }
+  return EPS{};
+}
+
+std::ostream &operator<<(std::ostream &os, const Span &span) {
+  return os << "[" << span.begin << ", " << span.end << ")";
+}
+}  // namespace fol::lexer
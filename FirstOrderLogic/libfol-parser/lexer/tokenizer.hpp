@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace fol::lexer {
+// Kinds are listed in the order of Lexeme alternatives
+enum class TokenKind {
+  EPS,
+  OPEN_BRACKET,
+  CLOSE_BRACKET,
+  FORALL,
+  EXISTS,
+  AND,
+  OR,
+  IMPLIES,
+  NOT,
+  COMMA,
+  DOT,
+  FUNCTION,
+  VARIABLE,
+  PREDICATE,
+  CONSTANT
+};
+
+using SymbolId = std::uint32_t;
+
+inline constexpr SymbolId kNoSymbol = ~SymbolId{0};
+
+// Interns symbol names into dense ids. Names are stored once and views
+// returned by Name stay valid for the lifetime of the table.
+class SymbolTable {
+ public:
+  SymbolId Intern(std::string_view name);
+
+  std::optional<SymbolId> Find(std::string_view name) const;
+
+  std::string_view Name(SymbolId id) const { return names_[id]; }
+
+  std::size_t size() const { return names_.size(); }
+
+ private:
+  std::deque<std::string> names_;
+  std::unordered_map<std::string_view, SymbolId> ids_;
+};
+
+// Offsets of a token in the source, end excluded
+struct Span {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+};
+
+struct Token {
+  TokenKind kind = TokenKind::EPS;
+  Span span;
+  // interned name of functions, variables, predicates and constants
+  SymbolId symbol = kNoSymbol;
+};
+
+// Tokenizer over a source it does not own, so the source must outlive it.
+// All state is kept per instance; symbols are interned into the table if one
+// is given. Yields EPS tokens once the source is exhausted.
+class Tokenizer {
+ public:
+  explicit Tokenizer(std::string_view source, SymbolTable *symbols = nullptr)
+      : source_(source), symbols_(symbols) {}
+
+  Token Next();
+
+  // offset of the next unread character, or of the offending one after an
+  // error
+  std::size_t position() const { return position_; }
+
+  std::string_view source() const { return source_; }
+
+  std::string_view Text(const Token &token) const {
+    return source_.substr(token.span.begin, token.span.end - token.span.begin);
+  }
+
+ private:
+  Token Symbol(TokenKind kind);
+
+  Token Punctuation(TokenKind kind, std::size_t length);
+
+  std::string_view source_;
+  std::size_t position_ = 0;
+  SymbolTable *symbols_;
+};
+
+Lexeme ToLexeme(const Token &token, std::string_view text);
+
+std::ostream &operator<<(std::ostream &os, const Span &span);
+}  // namespace fol::lexer
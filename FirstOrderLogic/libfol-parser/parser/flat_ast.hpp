@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libfol-parser/lexer/tokenizer.hpp>
+#include <libfol-parser/parser/exceptions.hpp>
+#include <libfol-parser/parser/types.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fol::parser::flat {
+using NodeId = std::uint32_t;
+
+enum class NodeKind : std::uint8_t {
+  CONSTANT,
+  VARIABLE,
+  FUNCTION,
+  PREDICATE,
+  NOT,
+  AND,
+  OR,
+  IMPLIES,
+  FORALL,
+  EXISTS
+};
+
+// Symbols keep their name in symbol, quantifiers keep their bound variable.
+// And and or are n-ary, implies has exactly two children.
+struct Node {
+  NodeKind kind;
+  lexer::SymbolId symbol = lexer::kNoSymbol;
+  std::uint32_t children_begin = 0;
+  std::uint32_t children_size = 0;
+};
+
+// Arena of the formulas of one problem. Nodes refer to their children by
+// index and the children of every node are stored contiguously, so nodes
+// are only added and the whole arena is freed at once by Clear.
+class Ast {
+ public:
+  NodeId Add(NodeKind kind, lexer::SymbolId symbol,
+             std::span<const NodeId> children = {});
+
+  const Node& operator[](NodeId id) const { return nodes_[id]; }
+
+  std::span<const NodeId> children(NodeId id) const {
+    auto& node = nodes_[id];
+    return {children_.data() + node.children_begin, node.children_size};
+  }
+
+  std::string_view Name(NodeId id) const {
+    return symbols_.Name(nodes_[id].symbol);
+  }
+
+  lexer::SymbolTable& symbols() { return symbols_; }
+  const lexer::SymbolTable& symbols() const { return symbols_; }
+
+  std::size_t size() const { return nodes_.size(); }
+
+  // Drops every node but keeps the memory and the symbols
+  void Clear();
+
+ private:
+  std::vector<Node> nodes_;
+  std::vector<NodeId> children_;
+  lexer::SymbolTable symbols_;
+};
+
+// ParseError with the offset of the offending token
+struct FlatParseError : ParseError {
+  FlatParseError(const std::string& what, std::size_t position)
+      : ParseError(what), position(position) {}
+
+  std::size_t position;
+};
+
+// Parses the whole source with the grammar of Parse
+NodeId ParseFlat(std::string_view source, Ast& ast);
+
+NodeId FromFol(const FolFormula& formula, Ast& ast);
+
+// Brackets are added around operands that need them
+FolFormula ToFol(const Ast& ast, NodeId id);
+}  // namespace fol::parser::flat
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <details/utils/mapped_file.hpp>
+#include <libfol-parser/parser/types.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace fol::parser {
+// Errors are prefixed with <file>:<line>: or <file>:<line>:<column>:
+struct ProblemError : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+// Text of one formula and the line it starts at
+struct FormulaSource {
+  std::string_view text;
+  std::size_t line = 0;
+};
+
+// Reads problems laid out as in remade_teorems: the number of axioms on the
+// first line, one axiom per line and the hypothesis on the remaining lines.
+// Files are mapped and formulas are handed out as views of the mapping.
+class ProblemReader {
+ public:
+  explicit ProblemReader(const std::string& path);
+
+  // name is only used in error messages
+  ProblemReader(std::string name, std::string source);
+
+  ProblemReader(const ProblemReader&) = delete;
+  ProblemReader& operator=(const ProblemReader&) = delete;
+
+  std::size_t axioms_count() const { return axioms_count_; }
+
+  // Empty after the last axiom. Blank lines are skipped.
+  std::optional<FormulaSource> NextAxiom();
+
+  // Must be called after the last axiom
+  FormulaSource Hypothesis();
+
+  // Safe to call from several threads at once
+  FolFormula Parse(const FormulaSource& source) const;
+
+  const std::string& name() const { return name_; }
+
+ private:
+  void ReadAxiomsCount();
+
+  std::string_view NextLine();
+
+  [[noreturn]] void Fail(std::size_t line, const std::string& what) const;
+
+  std::string name_;
+  std::optional<details::utils::MappedFile> file_;
+  std::string buffer_;
+  std::string_view source_;
+  std::size_t position_ = 0;
+  std::size_t line_ = 0;
+  std::size_t axioms_count_ = 0;
+  std::size_t axioms_read_ = 0;
+};
+}  // namespace fol::parser
@@ -0,0 +1,408 @@
+#include <details/utils/utility.hpp>
+#include <libfol-parser/parser/flat_ast.hpp>
+#include <variant>
+
+namespace fol::parser::flat {
+namespace {
+using lexer::TokenKind;
+
+// Collects operands of n-ary nodes on a stack shared by all nesting levels
+class Builder {
+ public:
+  explicit Builder(Ast& ast) : ast_(ast) {}
+
+  std::size_t mark() const { return stack_.size(); }
+
+  // operands of the same kind are merged into the new node
+  void PushOperand(NodeKind kind, NodeId id) {
+    if (ast_[id].kind == kind) {
+      auto children = ast_.children(id);
+      stack_.insert(stack_.end(), children.begin(), children.end());
+    } else {
+      stack_.push_back(id);
+    }
+  }
+
+  void Push(NodeId id) { stack_.push_back(id); }
+
+  NodeId Finish(NodeKind kind, lexer::SymbolId symbol, std::size_t mark) {
+    auto id = ast_.Add(kind, symbol,
+                       {stack_.data() + mark, stack_.size() - mark});
+    stack_.resize(mark);
+    return id;
+  }
+
+  // single operands stand for themselves
+  NodeId FinishNary(NodeKind kind, std::size_t mark) {
+    if (stack_.size() - mark == 1) {
+      auto id = stack_.back();
+      stack_.pop_back();
+      return id;
+    }
+    return Finish(kind, lexer::kNoSymbol, mark);
+  }
+
+  Ast& ast() { return ast_; }
+
+ private:
+  Ast& ast_;
+  std::vector<NodeId> stack_;
+};
+
+class FlatParser {
+ public:
+  FlatParser(std::string_view source, Ast& ast)
+      : tokenizer_(source, &ast.symbols()), builder_(ast) {
+    Advance();
+  }
+
+  NodeId Parse() {
+    auto id = Implication();
+    if (token_.kind != TokenKind::EPS) {
+      Fail("Unexpected lexeme after formula.");
+    }
+    return id;
+  }
+
+ private:
+  void Advance() {
+    try {
+      token_ = tokenizer_.Next();
+    } catch (const lexer::LexerError& e) {
+      throw FlatParseError{e.what(), tokenizer_.position()};
+    }
+  }
+
+  [[noreturn]] void Fail(const char* what) const {
+    throw FlatParseError{what, token_.span.begin};
+  }
+
+  void Expect(TokenKind kind, const char* what) {
+    if (token_.kind != kind) {
+      Fail(what);
+    }
+    Advance();
+  }
+
+  NodeId Implication() {
+    auto mark = builder_.mark();
+    builder_.Push(Disjunction());
+    if (token_.kind != TokenKind::IMPLIES) {
+      return builder_.FinishNary(NodeKind::IMPLIES, mark);
+    }
+    Advance();
+
+    builder_.Push(Implication());
+    return builder_.Finish(NodeKind::IMPLIES, lexer::kNoSymbol, mark);
+  }
+
+  NodeId Disjunction() {
+    auto mark = builder_.mark();
+    builder_.PushOperand(NodeKind::OR, Conjunction());
+    while (token_.kind == TokenKind::OR) {
+      Advance();
+      builder_.PushOperand(NodeKind::OR, Conjunction());
+    }
+    return builder_.FinishNary(NodeKind::OR, mark);
+  }
+
+  NodeId Conjunction() {
+    auto mark = builder_.mark();
+    builder_.PushOperand(NodeKind::AND, Unary());
+    while (token_.kind == TokenKind::AND) {
+      Advance();
+      builder_.PushOperand(NodeKind::AND, Unary());
+    }
+    return builder_.FinishNary(NodeKind::AND, mark);
+  }
+
+  NodeId Quantifier(NodeKind kind, const char* no_var, const char* no_dot) {
+    Advance();
+    if (token_.kind != TokenKind::VARIABLE) {
+      Fail(no_var);
+    }
+    auto var = token_.symbol;
+    Advance();
+    Expect(TokenKind::DOT, no_dot);
+
+    auto mark = builder_.mark();
+    builder_.Push(Implication());
+    return builder_.Finish(kind, var, mark);
+  }
+
+  NodeId Unary() {
+    switch (token_.kind) {
+      case TokenKind::OPEN_BRACKET: {
+        Advance();
+        auto id = Implication();
+        Expect(TokenKind::CLOSE_BRACKET, "No close bracket at (<impl>).");
+        return id;
+      }
+      case TokenKind::NOT: {
+        Advance();
+        auto mark = builder_.mark();
+        builder_.Push(Unary());
+        return builder_.Finish(NodeKind::NOT, lexer::kNoSymbol, mark);
+      }
+      case TokenKind::FORALL:
+        return Quantifier(
+            NodeKind::FORALL,
+            "Error in parsing @ <var> . <impl>: no variable after @.",
+            "Error in parsing @ <var> . <impl>: no . after <var>.");
+      case TokenKind::EXISTS:
+        return Quantifier(
+            NodeKind::EXISTS,
+            "Error in parsing ? <var> . <impl>: no variable after ?.",
+            "Error in parsing ? <var> . <impl>: no . after <var>.");
+      case TokenKind::PREDICATE: {
+        auto symbol = token_.symbol;
+        Advance();
+        Expect(TokenKind::OPEN_BRACKET, "No args for predicate.");
+        auto id = Arguments(NodeKind::PREDICATE, symbol);
+        Expect(TokenKind::CLOSE_BRACKET,
+               "No close bracket at args for predicate.");
+        return id;
+      }
+      default:
+        Fail("Unhandled variant in unary parsing");
+    }
+  }
+
+  NodeId Arguments(NodeKind kind, lexer::SymbolId symbol) {
+    auto mark = builder_.mark();
+    builder_.Push(Term());
+    while (token_.kind == TokenKind::COMMA) {
+      Advance();
+      builder_.Push(Term());
+    }
+    return builder_.Finish(kind, symbol, mark);
+  }
+
+  NodeId Term() {
+    auto symbol = token_.symbol;
+    switch (token_.kind) {
+      case TokenKind::CONSTANT:
+        Advance();
+        return builder_.ast().Add(NodeKind::CONSTANT, symbol);
+      case TokenKind::VARIABLE:
+        Advance();
+        return builder_.ast().Add(NodeKind::VARIABLE, symbol);
+      case TokenKind::FUNCTION: {
+        Advance();
+        Expect(TokenKind::OPEN_BRACKET, "No args for function.");
+        auto id = Arguments(NodeKind::FUNCTION, symbol);
+        Expect(TokenKind::CLOSE_BRACKET,
+               "No close bracket at args for function.");
+        return id;
+      }
+      default:
+        Fail("Unhandled variant in Term parsing.");
+    }
+  }
+
+  lexer::Tokenizer tokenizer_;
+  lexer::Token token_;
+  Builder builder_;
+};
+
+class FolConverter {
+ public:
+  explicit FolConverter(Ast& ast) : builder_(ast) {}
+
+  NodeId Implication(const ImplicationFormula& formula) {
+    if (formula.data.index() == 0) {
+      return Disjunction(std::get<0>(formula.data));
+    }
+
+    auto& pair = *std::get<1>(formula.data);
+    auto mark = builder_.mark();
+    builder_.Push(Disjunction(pair.first));
+    builder_.Push(Implication(pair.second));
+    return builder_.Finish(NodeKind::IMPLIES, lexer::kNoSymbol, mark);
+  }
+
+ private:
+  NodeId Disjunction(const DisjunctionFormula& formula) {
+    auto mark = builder_.mark();
+    builder_.PushOperand(NodeKind::OR, Conjunction(formula.data.first));
+    for (auto* prime = &formula.data.second; prime->data.index() == 0;) {
+      auto& pair = *std::get<0>(prime->data);
+      builder_.PushOperand(NodeKind::OR, Conjunction(pair.first));
+      prime = &pair.second;
+    }
+    return builder_.FinishNary(NodeKind::OR, mark);
+  }
+
+  NodeId Conjunction(const ConjunctionFormula& formula) {
+    auto mark = builder_.mark();
+    builder_.PushOperand(NodeKind::AND, Unary(formula.data->first));
+    for (auto* prime = &formula.data->second; prime->data.index() == 0;) {
+      auto& pair = *std::get<0>(prime->data);
+      builder_.PushOperand(NodeKind::AND, Unary(pair.first));
+      prime = &pair.second;
+    }
+    return builder_.FinishNary(NodeKind::AND, mark);
+  }
+
+  NodeId Quantifier(NodeKind kind,
+                    const std::pair<std::string, ImplicationFormula>& data) {
+    auto var = builder_.ast().symbols().Intern(data.first);
+    auto mark = builder_.mark();
+    builder_.Push(Implication(data.second));
+    return builder_.Finish(kind, var, mark);
+  }
+
+  NodeId Unary(const UnaryFormula& formula) {
+    return std::visit(
+        details::utils::Overloaded{
+            [&](const BracketFormula& bracket) {
+              return Implication(bracket.data);
+            },
+            [&](const NotFormula& not_formula) {
+              auto mark = builder_.mark();
+              builder_.Push(Unary(*not_formula.data));
+              return builder_.Finish(NodeKind::NOT, lexer::kNoSymbol, mark);
+            },
+            [&](const ForallFormula& forall) {
+              return Quantifier(NodeKind::FORALL, forall.data);
+            },
+            [&](const ExistsFormula& exists) {
+              return Quantifier(NodeKind::EXISTS, exists.data);
+            },
+            [&](const PredicateFormula& predicate) {
+              auto& symbols = builder_.ast().symbols();
+              return Arguments(NodeKind::PREDICATE,
+                               symbols.Intern(predicate.data.first),
+                               predicate.data.second);
+            }},
+        formula.data);
+  }
+
+  NodeId Arguments(NodeKind kind, lexer::SymbolId symbol,
+                   const TermList& term_list) {
+    auto mark = builder_.mark();
+    for (auto it = ConstTermListIt(const_cast<TermList*>(&term_list));
+         it != ConstTermListIt{}; ++it) {
+      builder_.Push(Term(*it));
+    }
+    return builder_.Finish(kind, symbol, mark);
+  }
+
+  NodeId Term(const parser::Term& term) {
+    auto& symbols = builder_.ast().symbols();
+    if (term.IsConstant()) {
+      return builder_.ast().Add(NodeKind::CONSTANT,
+                                symbols.Intern(term.Const()));
+    }
+    if (term.IsVar()) {
+      return builder_.ast().Add(NodeKind::VARIABLE, symbols.Intern(term.Var()));
+    }
+    return Arguments(NodeKind::FUNCTION,
+                     symbols.Intern(FunctionName(term.Function())),
+                     term.Function().data->second);
+  }
+
+  Builder builder_;
+};
+
+parser::Term ToTerm(const Ast& ast, NodeId id) {
+  auto& node = ast[id];
+  if (node.kind == NodeKind::CONSTANT) {
+    return {lexer::Constant{ast.Name(id)}};
+  }
+  if (node.kind == NodeKind::VARIABLE) {
+    return {lexer::Variable{ast.Name(id)}};
+  }
+
+  std::vector<parser::Term> args;
+  args.reserve(node.children_size);
+  for (auto child : ast.children(id)) {
+    args.push_back(ToTerm(ast, child));
+  }
+  return {lexer::Function{ast.Name(id)} * ToTermList(std::move(args))};
+}
+
+UnaryFormula ToUnary(const Ast& ast, NodeId id) {
+  auto& node = ast[id];
+  if (node.kind == NodeKind::PREDICATE) {
+    std::vector<parser::Term> args;
+    args.reserve(node.children_size);
+    for (auto child : ast.children(id)) {
+      args.push_back(ToTerm(ast, child));
+    }
+    return lexer::Predicate{ast.Name(id)} * ToTermList(std::move(args));
+  }
+  if (node.kind == NodeKind::NOT) {
+    return MakeNot(ToUnary(ast, ast.children(id).front()));
+  }
+  // quantifiers would capture whatever follows them
+  return MakeBrackets(ToFol(ast, id));
+}
+
+ConjunctionFormula ToConjunction(const Ast& ast, NodeId id) {
+  if (ast[id].kind != NodeKind::AND) {
+    return MakeConj(ToUnary(ast, id));
+  }
+
+  auto children = ast.children(id);
+  auto res = MakeConj(ToUnary(ast, children.back()));
+  for (auto it = children.rbegin() + 1; it != children.rend(); ++it) {
+    res = MakeConj(ToUnary(ast, *it), std::move(res));
+  }
+  return res;
+}
+
+DisjunctionFormula ToDisjunction(const Ast& ast, NodeId id) {
+  if (ast[id].kind != NodeKind::OR) {
+    return MakeDisj(ToConjunction(ast, id));
+  }
+
+  auto children = ast.children(id);
+  auto res = MakeDisj(ToConjunction(ast, children.back()));
+  for (auto it = children.rbegin() + 1; it != children.rend(); ++it) {
+    res = MakeDisj(ToConjunction(ast, *it), std::move(res));
+  }
+  return res;
+}
+}  // namespace
+
+NodeId Ast::Add(NodeKind kind, lexer::SymbolId symbol,
+                std::span<const NodeId> children) {
+  nodes_.push_back({kind, symbol, static_cast<std::uint32_t>(children_.size()),
+                    static_cast<std::uint32_t>(children.size())});
+  children_.insert(children_.end(), children.begin(), children.end());
+  return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+void Ast::Clear() {
+  nodes_.clear();
+  children_.clear();
+}
+
+NodeId ParseFlat(std::string_view source, Ast& ast) {
+  return FlatParser{source, ast}.Parse();
+}
+
+NodeId FromFol(const FolFormula& formula, Ast& ast) {
+  return FolConverter{ast}.Implication(formula);
+}
+
+FolFormula ToFol(const Ast& ast, NodeId id) {
+  auto& node = ast[id];
+  switch (node.kind) {
+    case NodeKind::IMPLIES: {
+      auto children = ast.children(id);
+      return MakeImpl(ToDisjunction(ast, children[0]),
+                      ToFol(ast, children[1]));
+    }
+    case NodeKind::FORALL:
+      return parser::ToFol(UnaryFormula{MakeForall(
+          std::string{ast.Name(id)}, ToFol(ast, ast.children(id).front()))});
+    case NodeKind::EXISTS:
+      return parser::ToFol(UnaryFormula{MakeExists(
+          std::string{ast.Name(id)}, ToFol(ast, ast.children(id).front()))});
+    default:
+      return MakeImpl(ToDisjunction(ast, id));
+  }
+}
+}  // namespace fol::parser::flat
@@ -82,7 +82,7 @@ std::ostream &operator<<(std::ostream &os, const Term &term) {
       details::utils::Overloaded{
           [&](const auto &var) -> std::ostream & { return os << var; },
       },
-      term.data);
+      term.data());
 }
 
 std::ostream &operator<<(std::ostream &os,
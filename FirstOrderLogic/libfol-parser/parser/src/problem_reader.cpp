@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-parser/parser/problem_reader.hpp>
+#include <system_error>
+
+namespace fol::parser {
+namespace {
+std::string_view Trim(std::string_view str) {
+  auto begin = details::utils::SkipWhiteSpaces(0, str);
+  auto end = str.size();
+  while (end > begin && std::isspace(str[end - 1])) {
+    --end;
+  }
+  return str.substr(begin, end - begin);
+}
+}  // namespace
+
+ProblemReader::ProblemReader(const std::string& path) : name_(path) {
+  try {
+    file_.emplace(path);
+  } catch (const std::system_error& e) {
+    throw ProblemError{e.what()};
+  }
+  source_ = file_->view();
+  ReadAxiomsCount();
+}
+
+ProblemReader::ProblemReader(std::string name, std::string source)
+    : name_(std::move(name)), buffer_(std::move(source)), source_(buffer_) {
+  ReadAxiomsCount();
+}
+
+void ProblemReader::ReadAxiomsCount() {
+  auto line = Trim(NextLine());
+  auto [end, error] =
+      std::from_chars(line.data(), line.data() + line.size(), axioms_count_);
+  if (line.empty() || error != std::errc{} ||
+      end != line.data() + line.size()) {
+    Fail(line_, "expected the number of axioms");
+  }
+}
+
+std::string_view ProblemReader::NextLine() {
+  auto end = source_.find('\n', position_);
+  if (end == std::string_view::npos) {
+    end = source_.size();
+  }
+
+  auto line = source_.substr(position_, end - position_);
+  position_ = std::min(end + 1, source_.size());
+  ++line_;
+  return line;
+}
+
+std::optional<FormulaSource> ProblemReader::NextAxiom() {
+  if (axioms_read_ == axioms_count_) {
+    return std::nullopt;
+  }
+
+  std::string_view text;
+  while (text.empty()) {
+    if (position_ == source_.size()) {
+      Fail(line_, "expected " + std::to_string(axioms_count_) +
+                      " axioms, found " + std::to_string(axioms_read_));
+    }
+    text = Trim(NextLine());
+  }
+
+  ++axioms_read_;
+  return FormulaSource{text, line_};
+}
+
+FormulaSource ProblemReader::Hypothesis() {
+  if (axioms_read_ != axioms_count_) {
+    Fail(line_, "hypothesis requested before the last axiom");
+  }
+
+  auto rest = source_.substr(position_);
+  auto text = Trim(rest);
+  if (text.empty()) {
+    Fail(line_, "expected a hypothesis");
+  }
+
+  auto skipped = rest.substr(0, text.data() - rest.data());
+  auto line = line_ + 1 + std::count(skipped.begin(), skipped.end(), '\n');
+  position_ = source_.size();
+  return {text, static_cast<std::size_t>(line)};
+}
+
+FolFormula ProblemReader::Parse(const FormulaSource& source) const {
+  std::string error;
+  try {
+    return parser::Parse(lexer::TokenizeView(source.text));
+  } catch (const ParseError& e) {
+    error = e.what();
+  } catch (const lexer::LexerError& e) {
+    error = e.what();
+  }
+
+  // lexer::i is thread_local and points at or after the offending lexeme
+  auto position = std::min<std::size_t>(lexer::i, source.text.size());
+  auto before = source.text.substr(0, position);
+  auto line_begin = before.rfind('\n');
+  auto column = line_begin == std::string_view::npos ? position + 1
+                                                     : position - line_begin;
+  auto line = source.line + std::count(before.begin(), before.end(), '\n');
+  throw ProblemError{name_ + ":" + std::to_string(line) + ":" +
+                     std::to_string(column) + ": " + error};
+}
+
+void ProblemReader::Fail(std::size_t line, const std::string& what) const {
+  throw ProblemError{name_ + ":" + std::to_string(line) + ": " + what};
+}
+}  // namespace fol::parser
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <functional>
 #include <libfol-parser/parser/types.hpp>
 
 namespace fol::parser {
@@ -6,6 +8,33 @@ bool operator==(const FunctionFormula& lhs, const FunctionFormula& rhs) {
          lhs.data->second == rhs.data->second;
 }
 
+std::uint64_t VarBit(std::string_view var) {
+  return std::uint64_t{1} << (std::hash<std::string_view>{}(var) % 64);
+}
+
+void Term::SetVar(std::string name) {
+  std::get<1>(data_).base() = std::move(name);
+  UpdateInfo();
+}
+
+void Term::UpdateInfo() {
+  if (IsConstant()) {
+    info_ = TermInfo{};
+  } else if (IsVar()) {
+    info_ = TermInfo{false, VarBit(Var()), 0, 1};
+  } else {
+    info_ = TermInfo{};
+    const auto& function = std::get<2>(data_);
+    for (auto it = FunctionTermsIt(function); it != ConstTermListIt{}; ++it) {
+      auto& arg = it->info();
+      info_.ground = info_.ground && arg.ground;
+      info_.vars |= arg.vars;
+      info_.depth = std::max(info_.depth, arg.depth + 1);
+      info_.weight += arg.weight;
+    }
+  }
+}
+
 bool operator==(const Term& lhs, const Term& rhs) {
   return std::visit(
       [](auto&& lhs_a, auto&& rhs_a) {
@@ -15,7 +44,7 @@ bool operator==(const Term& lhs, const Term& rhs) {
           return false;
         }
       },
-      lhs.data, rhs.data);
+      lhs.data(), rhs.data());
 }
 
 bool operator==(const TermListPrime& lhs, const TermListPrime& rhs) {
@@ -36,7 +65,7 @@ bool operator==(const TermListPrime& lhs, const TermListPrime& rhs) {
 }
 
 bool operator==(const TermList& lhs, const TermList& rhs) {
-  return lhs.data.first == rhs.data.first && rhs.data.second == rhs.data.second;
+  return lhs.data.first == rhs.data.first && lhs.data.second == rhs.data.second;
 }
 
 bool operator==(const ConjunctionPrimeFormula& lhs,
@@ -371,6 +400,15 @@ std::vector<Term> FromTermList(parser::TermList term_list) {
   return terms;
 }
 
+TermList ToTermList(std::vector<Term> terms) {
+  TermList term_list{std::move(terms.back())};
+  for (auto it = terms.rbegin() + 1; it != terms.rend(); ++it) {
+    term_list = std::move(*it) |= std::move(term_list);
+  }
+
+  return term_list;
+}
+
 const std::string& FunctionName(const FunctionFormula& fun) {
   return fun.data->first;
 }
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <libfol-parser/lexer/lexer.hpp>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 
@@ -28,24 +30,57 @@ struct FunctionFormula {
 
 bool operator==(const FunctionFormula& lhs, const FunctionFormula& rhs);
 
+// Facts about a term cached when it is built
+struct TermInfo {
+  bool ground = true;
+  // VarBit of every variable of the term
+  std::uint64_t vars = 0;
+  std::uint32_t depth = 0;
+  // number of symbols
+  std::uint32_t weight = 1;
+};
+
+std::uint64_t VarBit(std::string_view var);
+
 struct Term {
   Term() = default;
-  Term(lexer::Constant c) : data(c) {}
-  Term(lexer::Variable v) : data(v) {}
-  Term(FunctionFormula f) : data(std::move(f)) {}
-
-  bool IsConstant() const { return data.index() == 0; }
-  bool IsVar() const { return data.index() == 1; }
-  bool IsFunction() const { return data.index() == 2; }
-
-  const auto& Const() const { return std::get<0>(data); }
-  auto& Const() { return std::get<0>(data); }
-  const auto& Var() const { return std::get<1>(data); }
-  auto& Var() { return std::get<1>(data); }
-  const auto& Function() const { return std::get<2>(data); }
-  auto& Function() { return std::get<2>(data); }
-
-  std::variant<lexer::Constant, lexer::Variable, FunctionFormula> data;
+  Term(lexer::Constant c) : data_(c) { UpdateInfo(); }
+  Term(lexer::Variable v) : data_(v) { UpdateInfo(); }
+  Term(FunctionFormula f) : data_(std::move(f)) { UpdateInfo(); }
+
+  const TermInfo& info() const { return info_; }
+
+  bool IsConstant() const { return data_.index() == 0; }
+  bool IsVar() const { return data_.index() == 1; }
+  bool IsFunction() const { return data_.index() == 2; }
+
+  const auto& Const() const& { return std::get<0>(data_); }
+  const auto& Var() const& { return std::get<1>(data_); }
+  const auto& Function() const& { return std::get<2>(data_); }
+
+  // moves out of a term that is not used any more
+  auto&& Const() && { return std::get<0>(std::move(data_)); }
+  auto&& Var() && { return std::get<1>(std::move(data_)); }
+  auto&& Function() && { return std::get<2>(std::move(data_)); }
+
+  const auto& data() const { return data_; }
+
+  // Terms change in place only through these, which keep info() current
+  void SetVar(std::string name);
+
+  // Calls f with the function of a function term, whose arguments f may
+  // change in place
+  template <class F>
+  void ModifyFunction(F&& f) {
+    std::forward<F>(f)(std::get<2>(data_));
+    UpdateInfo();
+  }
+
+ private:
+  void UpdateInfo();
+
+  std::variant<lexer::Constant, lexer::Variable, FunctionFormula> data_;
+  TermInfo info_;
 };
 
 bool operator==(const Term& lhs, const Term& rhs);
@@ -307,6 +342,8 @@ std::pair<Term, std::optional<parser::TermList>> PopTermList(
 
 std::vector<Term> FromTermList(parser::TermList term_list);
 
+TermList ToTermList(std::vector<Term> terms);
+
 const std::string& FunctionName(const FunctionFormula& fun);
 
 TermListIt FunctionTermsIt(FunctionFormula& fun);
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <libfol-parser/parser/flat_ast.hpp>
+#include <span>
+#include <vector>
+
+namespace fol::prover {
+struct SineOptions {
+  // rounds of triggering from the symbols of the hypothesis, 0 for no limit
+  std::size_t depth = 0;
+  // a symbol triggers the axioms it occurs in if it occurs in at most
+  // tolerance times as many axioms as their rarest symbol
+  double tolerance = 1.0;
+};
+
+// SInE selection: the symbols of the hypothesis trigger axioms, whose symbols
+// trigger axioms in the next round. Predicates, functions and constants are
+// symbols. Returns the indices of the triggered axioms in increasing order.
+std::vector<std::size_t> SelectAxioms(
+    const parser::flat::Ast& ast, std::span<const parser::flat::NodeId> axioms,
+    parser::flat::NodeId hypothesis, const SineOptions& options = {});
+}  // namespace fol::prover
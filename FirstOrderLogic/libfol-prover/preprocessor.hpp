@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <libfol-basictypes/clause.hpp>
+#include <libfol-unification/unification_interface.hpp>
+#include <memory>
+#include <vector>
+
+namespace fol::prover {
+// Clause of the input set and whether it comes from the hypothesis
+struct InputClause {
+  types::Clause clause;
+  bool hypothesis;
+};
+
+// Shrinks the input clause set before saturation, keeping it unsatisfiable
+// if it was. Clauses shortened by a ground unit get the unit and the
+// original clause as ancestors; a clause that takes the place of a removed
+// hypothesis clause comes from the hypothesis too.
+class Preprocessor {
+ public:
+  Preprocessor() = default;
+
+  // Predicates are also eliminated by resolution with unificator, if the
+  // resolvents have at most growth more clauses and literals than the
+  // clauses they replace
+  explicit Preprocessor(std::unique_ptr<unification::IUnificator> unificator,
+                        std::size_t growth = 0)
+      : unificator_(std::move(unificator)), growth_(growth) {}
+
+  struct Stats {
+    std::size_t tautologies = 0;
+    std::size_t duplicates = 0;
+    // literals removed by ground units
+    std::size_t propagated = 0;
+    std::size_t subsumed = 0;
+    std::size_t pure = 0;
+    // predicates resolved away
+    std::size_t eliminated = 0;
+  };
+
+  // The simplified set. If the empty clause is derived, it is the only one.
+  std::vector<InputClause> Run(std::vector<InputClause> clauses);
+
+  const Stats& stats() const { return stats_; }
+
+ private:
+  void RemoveTautologies(std::vector<InputClause>& clauses);
+  void RemoveDuplicates(std::vector<InputClause>& clauses);
+  // false if the empty clause is derived, it is then the last one
+  bool PropagateGroundUnits(std::vector<InputClause>& clauses);
+  void RemoveSubsumed(std::vector<InputClause>& clauses);
+  void RemovePure(std::vector<InputClause>& clauses);
+  // false if the empty clause is derived, it is then the last one
+  bool EliminatePredicates(std::vector<InputClause>& clauses);
+
+  std::unique_ptr<unification::IUnificator> unificator_;
+  std::size_t growth_ = 0;
+  Stats stats_;
+};
+
+std::ostream& operator<<(std::ostream& os, const Preprocessor::Stats& stats);
+}  // namespace fol::prover
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <libfol-prover/axiom_selection.hpp>
+#include <limits>
+#include <utility>
+
+namespace fol::prover {
+namespace {
+using parser::flat::NodeKind;
+
+// Distinct symbols of a formula, sorted
+std::vector<lexer::SymbolId> Symbols(const parser::flat::Ast& ast,
+                                     parser::flat::NodeId root) {
+  std::vector<lexer::SymbolId> symbols;
+  std::vector<parser::flat::NodeId> stack{root};
+  while (!stack.empty()) {
+    auto id = stack.back();
+    stack.pop_back();
+    auto kind = ast[id].kind;
+    if (kind == NodeKind::PREDICATE || kind == NodeKind::FUNCTION ||
+        kind == NodeKind::CONSTANT) {
+      symbols.push_back(ast[id].symbol);
+    }
+    auto children = ast.children(id);
+    stack.insert(stack.end(), children.begin(), children.end());
+  }
+  std::sort(symbols.begin(), symbols.end());
+  symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+  return symbols;
+}
+}  // namespace
+
+std::vector<std::size_t> SelectAxioms(
+    const parser::flat::Ast& ast, std::span<const parser::flat::NodeId> axioms,
+    parser::flat::NodeId hypothesis, const SineOptions& options) {
+  std::vector<std::vector<lexer::SymbolId>> symbols;
+  symbols.reserve(axioms.size());
+  // number of axioms every symbol occurs in
+  std::vector<std::size_t> occurrences(ast.symbols().size());
+  for (auto axiom : axioms) {
+    symbols.push_back(Symbols(ast, axiom));
+    for (auto symbol : symbols.back()) {
+      ++occurrences[symbol];
+    }
+  }
+
+  std::vector<std::vector<std::size_t>> triggered(occurrences.size());
+  for (std::size_t i = 0; i < axioms.size(); ++i) {
+    auto rarest = std::numeric_limits<std::size_t>::max();
+    for (auto symbol : symbols[i]) {
+      rarest = std::min(rarest, occurrences[symbol]);
+    }
+    for (auto symbol : symbols[i]) {
+      if (occurrences[symbol] <= options.tolerance * rarest) {
+        triggered[symbol].push_back(i);
+      }
+    }
+  }
+
+  std::vector<bool> selected(axioms.size());
+  std::vector<bool> seen(occurrences.size());
+  std::vector<lexer::SymbolId> round;
+  for (auto symbol : Symbols(ast, hypothesis)) {
+    seen[symbol] = true;
+    round.push_back(symbol);
+  }
+  for (std::size_t depth = 0;
+       !round.empty() && (options.depth == 0 || depth < options.depth);
+       ++depth) {
+    std::vector<lexer::SymbolId> next;
+    for (auto symbol : round) {
+      for (auto i : triggered[symbol]) {
+        if (selected[i]) {
+          continue;
+        }
+        selected[i] = true;
+        for (auto other : symbols[i]) {
+          if (!seen[other]) {
+            seen[other] = true;
+            next.push_back(other);
+          }
+        }
+      }
+    }
+    round = std::move(next);
+  }
+
+  std::vector<std::size_t> res;
+  for (std::size_t i = 0; i < axioms.size(); ++i) {
+    if (selected[i]) {
+      res.push_back(i);
+    }
+  }
+  return res;
+}
+}  // namespace fol::prover
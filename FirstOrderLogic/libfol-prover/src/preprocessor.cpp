@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <libfol-parser/parser/print.hpp>
+#include <libfol-prover/preprocessor.hpp>
+#include <libfol-unification/matching.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol::prover {
+namespace {
+bool Complementary(const types::Atom& lhs, const types::Atom& rhs) {
+  return lhs.negative() != rhs.negative() &&
+         lhs.predicate_name() == rhs.predicate_name() &&
+         lhs.terms_size() == rhs.terms_size() &&
+         std::equal(lhs.terms().begin(), lhs.terms().end(),
+                    rhs.terms().begin());
+}
+
+// Literal without its sign
+std::string Key(const types::Atom& atom) {
+  auto key = parser::ToString(atom);
+  return atom.negative() ? key.substr(1) : key;
+}
+
+// Bit per signed predicate, a clause subsumes only clauses with all its bits
+std::uint64_t SymbolMask(const types::Clause& clause) {
+  std::uint64_t mask = 0;
+  for (auto& atom : clause.atoms()) {
+    auto hash = std::hash<std::string>{}(atom.predicate_name()) * 2 +
+                atom.negative();
+    mask |= std::uint64_t{1} << (hash % 64);
+  }
+  return mask;
+}
+
+// Signed predicates in order, equal for variants
+std::string Signature(const types::Clause& clause) {
+  std::vector<std::string> symbols;
+  symbols.reserve(clause.atoms().size());
+  for (auto& atom : clause.atoms()) {
+    symbols.push_back((atom.negative() ? "~" : "") + atom.predicate_name());
+  }
+  std::sort(symbols.begin(), symbols.end());
+  std::string res;
+  for (auto& symbol : symbols) {
+    res += symbol + ",";
+  }
+  return res;
+}
+
+bool IsTautology(const types::Clause& clause) {
+  auto& atoms = clause.atoms();
+  for (std::size_t i = 0; i < atoms.size(); ++i) {
+    for (std::size_t j = i + 1; j < atoms.size(); ++j) {
+      if (Complementary(atoms[i], atoms[j])) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void CollectVars(const types::Term& term, std::set<types::Variable>& vars) {
+  if (term.IsVar()) {
+    vars.insert(term.Var());
+  } else if (term.IsFunction()) {
+    for (auto it = parser::FunctionTermsIt(term.Function());
+         it != parser::ConstTermListIt{}; ++it) {
+      CollectVars(*it, vars);
+    }
+  }
+}
+
+// Copy of the clause with fresh variables, named v#<renamed>. No variable of
+// a parsed formula has a # in its name.
+types::Clause RenameApart(types::Clause clause, std::size_t& renamed) {
+  std::set<types::Variable> vars;
+  for (auto& atom : clause.atoms()) {
+    for (auto& term : atom.terms()) {
+      CollectVars(term, vars);
+    }
+  }
+  for (auto& var : vars) {
+    auto name = "v#" + std::to_string(renamed++);
+    types::Term fresh{lexer::Variable{std::string_view{name}}};
+    for (auto& atom : clause.atoms()) {
+      atom.Substitute(var, fresh);
+    }
+  }
+  return clause;
+}
+
+// Elimination of a predicate is only tried if it gives at most this many
+// resolvents
+constexpr std::size_t kMaxResolutions = 64;
+
+template <class Pred>
+std::size_t EraseIf(std::vector<InputClause>& clauses, Pred pred) {
+  auto it = std::remove_if(clauses.begin(), clauses.end(), pred);
+  auto erased = static_cast<std::size_t>(clauses.end() - it);
+  clauses.erase(it, clauses.end());
+  return erased;
+}
+
+std::size_t EraseMarked(std::vector<InputClause>& clauses,
+                        const std::vector<bool>& marked) {
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < clauses.size(); ++i) {
+    if (!marked[i]) {
+      if (kept != i) {
+        clauses[kept] = std::move(clauses[i]);
+      }
+      ++kept;
+    }
+  }
+  auto erased = clauses.size() - kept;
+  clauses.erase(clauses.begin() + kept, clauses.end());
+  return erased;
+}
+}  // namespace
+
+std::vector<InputClause> Preprocessor::Run(std::vector<InputClause> clauses) {
+  RemoveTautologies(clauses);
+  RemoveDuplicates(clauses);
+  if (!PropagateGroundUnits(clauses)) {
+    std::vector<InputClause> res;
+    res.push_back(std::move(clauses.back()));
+    return res;
+  }
+  RemoveSubsumed(clauses);
+  RemovePure(clauses);
+
+  const auto eliminated = stats_.eliminated;
+  if (!EliminatePredicates(clauses)) {
+    std::vector<InputClause> res;
+    res.push_back(std::move(clauses.back()));
+    return res;
+  }
+  // resolvents may subsume each other or the remaining clauses
+  if (stats_.eliminated != eliminated) {
+    RemoveSubsumed(clauses);
+  }
+  return clauses;
+}
+
+void Preprocessor::RemoveTautologies(std::vector<InputClause>& clauses) {
+  stats_.tautologies += EraseIf(clauses, [](const InputClause& input) {
+    return IsTautology(input.clause);
+  });
+}
+
+void Preprocessor::RemoveDuplicates(std::vector<InputClause>& clauses) {
+  std::unordered_map<std::string, std::vector<std::size_t>> variants;
+  std::vector<bool> duplicate(clauses.size());
+  for (std::size_t i = 0; i < clauses.size(); ++i) {
+    auto& clause = clauses[i].clause;
+    auto& candidates = variants[Signature(clause)];
+    auto kept = std::find_if(
+        candidates.begin(), candidates.end(), [&](std::size_t j) {
+          auto& other = clauses[j].clause;
+          return other.atoms().size() == clause.atoms().size() &&
+                 unification::Subsumes(other, clause) &&
+                 unification::Subsumes(clause, other);
+        });
+    if (kept == candidates.end()) {
+      candidates.push_back(i);
+      continue;
+    }
+    duplicate[i] = true;
+    clauses[*kept].hypothesis |= clauses[i].hypothesis;
+  }
+
+  stats_.duplicates += EraseMarked(clauses, duplicate);
+}
+
+bool Preprocessor::PropagateGroundUnits(std::vector<InputClause>& clauses) {
+  // ground unit literal without its sign -> index of its clause
+  std::unordered_map<std::string, std::size_t> units;
+  for (bool changed = true; changed;) {
+    changed = false;
+    units.clear();
+    for (std::size_t i = 0; i < clauses.size(); ++i) {
+      auto& atoms = clauses[i].clause.atoms();
+      if (atoms.size() == 1 && atoms.front().info().ground) {
+        units.try_emplace(Key(atoms.front()), i);
+      }
+    }
+
+    for (std::size_t i = 0; i < clauses.size(); ++i) {
+      auto& input = clauses[i];
+      std::vector<types::Atom> atoms;
+      std::vector<std::size_t> resolved;
+      for (auto& atom : input.clause.atoms()) {
+        if (atom.info().ground) {
+          auto unit = units.find(Key(atom));
+          if (unit != units.end() && unit->second != i &&
+              clauses[unit->second].clause.atoms().front().negative() !=
+                  atom.negative()) {
+            if (std::find(resolved.begin(), resolved.end(), unit->second) ==
+                resolved.end()) {
+              resolved.push_back(unit->second);
+            }
+            ++stats_.propagated;
+            continue;
+          }
+        }
+        atoms.push_back(atom);
+      }
+      if (resolved.empty()) {
+        continue;
+      }
+
+      InputClause shortened{types::Clause{std::move(atoms)},
+                            input.hypothesis};
+      shortened.clause.AddAncestor(input.clause);
+      for (auto unit : resolved) {
+        shortened.clause.AddAncestor(clauses[unit].clause);
+        shortened.hypothesis |= clauses[unit].hypothesis;
+      }
+      if (shortened.clause.empty()) {
+        clauses.push_back(std::move(shortened));
+        return false;
+      }
+      // a clause that becomes a unit changes the units
+      changed = shortened.clause.atoms().size() == 1;
+      input = std::move(shortened);
+      if (changed) {
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+void Preprocessor::RemoveSubsumed(std::vector<InputClause>& clauses) {
+  std::vector<std::uint64_t> masks;
+  masks.reserve(clauses.size());
+  for (auto& input : clauses) {
+    masks.push_back(SymbolMask(input.clause));
+  }
+
+  // D removes C if it is shorter, or as long and earlier, so that of the
+  // clauses subsuming each other the first one is kept
+  auto before = [&](std::size_t d, std::size_t c) {
+    auto d_size = clauses[d].clause.atoms().size();
+    auto c_size = clauses[c].clause.atoms().size();
+    return d_size < c_size || (d_size == c_size && d < c);
+  };
+  std::vector<bool> subsumed(clauses.size());
+  for (std::size_t c = 0; c < clauses.size(); ++c) {
+    for (std::size_t d = 0; d < clauses.size(); ++d) {
+      if (before(d, c) && (masks[d] & ~masks[c]) == 0 &&
+          unification::Subsumes(clauses[d].clause, clauses[c].clause)) {
+        subsumed[c] = true;
+        clauses[d].hypothesis |= clauses[c].hypothesis;
+        break;
+      }
+    }
+  }
+
+  stats_.subsumed += EraseMarked(clauses, subsumed);
+}
+
+void Preprocessor::RemovePure(std::vector<InputClause>& clauses) {
+  for (std::size_t removed = 1; removed > 0;) {
+    // predicate -> 1 if it occurs positive, | 2 if negative
+    std::unordered_map<std::string, int> polarity;
+    for (auto& input : clauses) {
+      for (auto& atom : input.clause.atoms()) {
+        polarity[atom.predicate_name()] |= atom.negative() ? 2 : 1;
+      }
+    }
+    removed = EraseIf(clauses, [&](const InputClause& input) {
+      auto& atoms = input.clause.atoms();
+      return std::any_of(atoms.begin(), atoms.end(), [&](auto& atom) {
+        return polarity[atom.predicate_name()] != 3;
+      });
+    });
+    stats_.pure += removed;
+  }
+}
+
+bool Preprocessor::EliminatePredicates(std::vector<InputClause>& clauses) {
+  if (!unificator_) {
+    return true;
+  }
+
+  // Clause and literal of every occurrence of a predicate. Only predicates
+  // with at most one literal in every clause are eliminated.
+  struct Occurrences {
+    std::vector<std::pair<std::size_t, std::size_t>> positive;
+    std::vector<std::pair<std::size_t, std::size_t>> negative;
+    bool once_per_clause = true;
+  };
+  // predicates whose resolvents exceeded the bound
+  std::set<std::string> rejected;
+  std::size_t renamed = 0;
+  for (bool changed = true; changed;) {
+    changed = false;
+    std::map<std::string, Occurrences> occurrences;
+    for (std::size_t i = 0; i < clauses.size(); ++i) {
+      auto& atoms = clauses[i].clause.atoms();
+      for (std::size_t j = 0; j < atoms.size(); ++j) {
+        auto& occurrence = occurrences[atoms[j].predicate_name()];
+        auto in_clause = [i](auto& literals) {
+          return !literals.empty() && literals.back().first == i;
+        };
+        if (in_clause(occurrence.positive) || in_clause(occurrence.negative)) {
+          occurrence.once_per_clause = false;
+        }
+        (atoms[j].negative() ? occurrence.negative : occurrence.positive)
+            .emplace_back(i, j);
+      }
+    }
+
+    // the predicates with the fewest resolvents are tried first
+    std::vector<std::pair<std::size_t, const std::string*>> candidates;
+    for (auto& [predicate, occurrence] : occurrences) {
+      auto resolutions =
+          occurrence.positive.size() * occurrence.negative.size();
+      if (occurrence.once_per_clause && resolutions <= kMaxResolutions &&
+          !rejected.contains(predicate)) {
+        candidates.emplace_back(resolutions, &predicate);
+      }
+    }
+    std::stable_sort(
+        candidates.begin(), candidates.end(),
+        [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+
+    for (auto& [resolutions, predicate] : candidates) {
+      auto& occurrence = occurrences[*predicate];
+      std::vector<bool> removed(clauses.size());
+      std::size_t removed_clauses = 0;
+      std::size_t removed_literals = 0;
+      for (auto* literals : {&occurrence.positive, &occurrence.negative}) {
+        for (auto [i, j] : *literals) {
+          removed[i] = true;
+          ++removed_clauses;
+          removed_literals += clauses[i].clause.atoms().size();
+        }
+      }
+
+      std::vector<InputClause> resolvents;
+      std::size_t literals = 0;
+      // clauses of one formula share variable names
+      std::vector<types::Clause> negative;
+      for (auto [ni, nj] : occurrence.negative) {
+        negative.push_back(RenameApart(clauses[ni].clause, renamed));
+      }
+      for (auto [pi, pj] : occurrence.positive) {
+        for (std::size_t k = 0; k < negative.size(); ++k) {
+          auto [ni, nj] = occurrence.negative[k];
+          auto resolvent = unificator_->Resolution(clauses[pi].clause, pj,
+                                                   negative[k], nj);
+          if (!resolvent || IsTautology(*resolvent)) {
+            continue;
+          }
+          const bool hypothesis =
+              clauses[pi].hypothesis || clauses[ni].hypothesis;
+          if (resolvent->empty()) {
+            clauses.push_back({std::move(*resolvent), hypothesis});
+            return false;
+          }
+          literals += resolvent->atoms().size();
+          resolvents.push_back({std::move(*resolvent), hypothesis});
+        }
+      }
+      if (resolvents.size() > removed_clauses + growth_ ||
+          literals > removed_literals + growth_) {
+        rejected.insert(*predicate);
+        continue;
+      }
+
+      EraseMarked(clauses, removed);
+      for (auto& resolvent : resolvents) {
+        clauses.push_back(std::move(resolvent));
+      }
+      ++stats_.eliminated;
+      // the occurrences of the other predicates are out of date
+      changed = true;
+      break;
+    }
+  }
+  return true;
+}
+
+std::ostream& operator<<(std::ostream& os, const Preprocessor::Stats& stats) {
+  return os << stats.tautologies << " tautologies, " << stats.duplicates
+            << " duplicates, " << stats.propagated
+            << " literals of ground units, " << stats.subsumed
+            << " subsumed, " << stats.pure << " with pure literals, "
+            << stats.eliminated << " predicates eliminated";
+}
+}  // namespace fol::prover
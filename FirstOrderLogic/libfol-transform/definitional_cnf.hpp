@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <libfol-parser/parser/types.hpp>
+#include <optional>
+
+namespace fol::transform {
+// Formulas whose CNF by distribution has more clauses get definitions
+inline constexpr std::size_t kMaxDistributedClauses = 64;
+
+// Structure-preserving clausification of a prenex formula whose matrix is in
+// negation normal form. Disjunctions whose distribution would produce more
+// than max_clauses clauses get a subformula replaced by a fresh pdef
+// predicate over its variables. As the matrix is in negation normal form
+// only the pdef -> subformula half of a definition is added.
+// Empty if distribution stays within max_clauses or the formula has some
+// other shape, then ToCNF is to be used.
+std::optional<parser::FolFormula> ToDefinitionalCNF(
+    const parser::FolFormula& formula,
+    std::size_t max_clauses = kMaxDistributedClauses);
+}  // namespace fol::transform
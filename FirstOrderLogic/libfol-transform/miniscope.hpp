@@ -0,0 +1,12 @@
+#pragma once
+
+#include <libfol-parser/parser/types.hpp>
+
+namespace fol::transform {
+// Pushes every quantifier inward as far as it goes: past the disjuncts and
+// conjuncts its variable does not occur in, forall into each conjunct and
+// exists into each disjunct. Quantifiers whose variable does not occur are
+// dropped. Skolem functions of a miniscoped formula only take the universal
+// variables the existential depends on.
+parser::FolFormula Miniscope(parser::FolFormula formula);
+}  // namespace fol::transform
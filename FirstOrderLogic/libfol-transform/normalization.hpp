@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <libfol-matcher/check_matcher.hpp>
 #include <libfol-matcher/matcher.hpp>
 #include <libfol-parser/lexer/lexer.hpp>
@@ -11,6 +12,10 @@
 #include "details/utils/utility.hpp"
 
 namespace fol::transform {
+// Changes whenever Normalize changes its clauses, fresh names or context
+// counters, so that clauses cached by another build are not reused
+inline constexpr std::uint32_t kNormalizationVersion = 4;
+
 parser::FolFormula Normalize(parser::FolFormula formula);
 
 parser::FolFormula DeleteUselessBrackets(parser::FolFormula formula);
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cppcoro/generator.hpp>
+#include <cstddef>
+#include <libfol-parser/parser/types.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fol::transform {
+// Formula text with the bound variables numbered in binding order, equal for
+// formulas that differ only in the names of their bound variables
+std::string AlphaKey(const parser::FolFormula& formula);
+
+// Clauses of normalized formulas, looked up by the AlphaKey of every top-level
+// conjunct apart. A conjunct seen before gets a copy of its clauses, skolem
+// functions and definitions included: equal formulas may share witnesses.
+class NormalizationCache {
+ public:
+  struct Stats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+  };
+
+  // Disjunctions of the normalized formula, in conjunct order. Every conjunct
+  // is normalized when the generator gets to it.
+  cppcoro::generator<parser::FolFormula> Clausify(parser::FolFormula formula);
+
+  const Stats& stats() const { return stats_; }
+
+ private:
+  std::unordered_map<std::string, std::vector<parser::FolFormula>> clauses_;
+  Stats stats_;
+};
+}  // namespace fol::transform
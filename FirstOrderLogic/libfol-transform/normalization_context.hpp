@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace fol::transform {
+// Source of fresh names for normalization. Every thread takes names from its
+// current context, so formulas normalized in different contexts share no
+// state. A prefix made of name characters and ending with a letter keeps the
+// names of a context apart from those of any other prefix.
+class NormalizationContext {
+ public:
+  NormalizationContext() = default;
+
+  explicit NormalizationContext(std::string prefix)
+      : prefix_(std::move(prefix)) {}
+
+  std::string FreshVar() { return "vu" + prefix_ + std::to_string(++names_); }
+
+  std::string FreshConst() {
+    return "cu" + prefix_ + std::to_string(++names_);
+  }
+
+  std::string FreshPredicate() {
+    return "pdef" + prefix_ + std::to_string(++names_);
+  }
+
+  std::string FreshFunction() {
+    return "funiq" + prefix_ + std::to_string(functions_++);
+  }
+
+  // Numbers of names handed out so far
+  std::size_t names() const { return names_; }
+  std::size_t functions() const { return functions_; }
+
+  // Skips the names that were handed out elsewhere, e.g. to cached clauses
+  void Skip(std::size_t names, std::size_t functions) {
+    names_ = std::max(names_, names);
+    functions_ = std::max(functions_, functions);
+  }
+
+  // The context of the innermost Scope on this thread, or a per-thread
+  // default one
+  static NormalizationContext& Current() {
+    static thread_local NormalizationContext default_context;
+    return current_ ? *current_ : default_context;
+  }
+
+  // Makes a context current on this thread for its lifetime
+  class Scope {
+   public:
+    explicit Scope(NormalizationContext& context)
+        : previous_(std::exchange(current_, &context)) {}
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() { current_ = previous_; }
+
+   private:
+    NormalizationContext* previous_;
+  };
+
+ private:
+  static inline thread_local NormalizationContext* current_ = nullptr;
+
+  std::string prefix_;
+  std::size_t names_ = 0;
+  std::size_t functions_ = 0;
+};
+}  // namespace fol::transform
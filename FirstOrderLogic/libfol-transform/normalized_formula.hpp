@@ -14,7 +14,9 @@ class NormalizedFormula {
   friend std::ostream &operator<<(std::ostream &os,
                                   NormalizedFormula const &formula);
 
-  std::vector<parser::FolFormula> GetDisjunctions() const;
+  // Conjuncts of the matrix
+  std::vector<parser::FolFormula> GetDisjunctions() const &;
+  std::vector<parser::FolFormula> GetDisjunctions() &&;
 
   parser::FolFormula ToFol() const;
 
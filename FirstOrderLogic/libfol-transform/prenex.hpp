@@ -0,0 +1,12 @@
+#pragma once
+
+#include <libfol-parser/parser/types.hpp>
+
+namespace fol::transform {
+// Prenex form in linear time. Bound variables are renamed apart from each
+// other and from the free ones, then every quantifier whose variable occurs
+// is pulled out in prefix order, flipped under a negation or left of an
+// implication. The matrix keeps the shape of the formula with the quantifiers
+// left as brackets.
+parser::FolFormula ToPrenex(parser::FolFormula formula);
+}  // namespace fol::transform
@@ -1,81 +1,282 @@
 #pragma once
 
 #include <cstdint>
+#include <details/utils/utility.hpp>
 #include <libfol-basictypes/term.hpp>
 #include <libfol-parser/lexer/lexer.hpp>
-#include <libfol-parser/parser/parser.hpp>
-#include <libfol-parser/parser/print.hpp>
 #include <libfol-parser/parser/types.hpp>
+#include <libfol-transform/normalization_context.hpp>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <variant>
 
 namespace fol::transform {
-inline std::size_t ReplaceAll(std::string& inout, std::string_view what,
-                              std::string_view with) {
-  std::size_t count{};
-  for (std::string::size_type pos{};
-       inout.npos != (pos = inout.find(what.data(), pos, what.length()));
-       pos += with.length(), ++count) {
-    inout.replace(pos, what.length(), with.data(), with.length());
+inline parser::Term Clone(const parser::Term& src);
+
+inline parser::TermList Clone(const parser::TermList& src) {
+  parser::TermList res{Clone(src.data.first)};
+  auto* res_tail = &res.data.second;
+  for (auto* tail = &src.data.second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<std::unique_ptr<parser::TermList>>(tail->data);
+    auto copy = std::make_unique<parser::TermList>(Clone(next.data.first));
+    auto* copy_tail = &copy->data.second;
+    res_tail->data = std::move(copy);
+    res_tail = copy_tail;
+    tail = &next.data.second;
+  }
+  return res;
+}
+
+inline parser::FunctionFormula Clone(const parser::FunctionFormula& src) {
+  return {std::make_unique<std::pair<lexer::Function, parser::TermList>>(
+      src.data->first, Clone(src.data->second))};
+}
+
+inline parser::Term Clone(const parser::Term& src) {
+  if (src.IsConstant()) {
+    return {src.Const()};
+  }
+  if (src.IsVar()) {
+    return {src.Var()};
+  }
+  return {Clone(src.Function())};
+}
+
+inline parser::ImplicationFormula Clone(const parser::ImplicationFormula& src);
+inline parser::UnaryFormula Clone(const parser::UnaryFormula& src);
+
+inline parser::ConjunctionPrimeFormula Clone(
+    const parser::ConjunctionPrimeFormula& src) {
+  if (std::holds_alternative<lexer::EPS>(src.data)) {
+    return {lexer::EPS{}};
+  }
+  auto& pair = *std::get<0>(src.data);
+  return {std::make_unique<
+      std::pair<parser::UnaryFormula, parser::ConjunctionPrimeFormula>>(
+      Clone(pair.first), Clone(pair.second))};
+}
+
+inline parser::ConjunctionFormula Clone(const parser::ConjunctionFormula& src) {
+  return {std::make_unique<
+      std::pair<parser::UnaryFormula, parser::ConjunctionPrimeFormula>>(
+      Clone(src.data->first), Clone(src.data->second))};
+}
+
+inline parser::DisjunctionPrimeFormula Clone(
+    const parser::DisjunctionPrimeFormula& src) {
+  if (std::holds_alternative<lexer::EPS>(src.data)) {
+    return {lexer::EPS{}};
+  }
+  auto& pair = *std::get<0>(src.data);
+  return {std::make_unique<
+      std::pair<parser::ConjunctionFormula, parser::DisjunctionPrimeFormula>>(
+      Clone(pair.first), Clone(pair.second))};
+}
+
+inline parser::DisjunctionFormula Clone(const parser::DisjunctionFormula& src) {
+  return {Clone(src.data.first), Clone(src.data.second)};
+}
+
+inline parser::ImplicationFormula Clone(const parser::ImplicationFormula& src) {
+  if (auto disj = std::get_if<parser::DisjunctionFormula>(&src.data)) {
+    return {Clone(*disj)};
+  }
+  auto& pair = *std::get<1>(src.data);
+  return parser::MakeImpl(Clone(pair.first), Clone(pair.second));
+}
+
+inline parser::BracketFormula Clone(const parser::BracketFormula& src) {
+  return {Clone(src.data)};
+}
+
+inline parser::NotFormula Clone(const parser::NotFormula& src) {
+  return {std::make_unique<parser::UnaryFormula>(Clone(*src.data))};
+}
+
+inline parser::ForallFormula Clone(const parser::ForallFormula& src) {
+  return {{src.data.first, Clone(src.data.second)}};
+}
+
+inline parser::ExistsFormula Clone(const parser::ExistsFormula& src) {
+  return {{src.data.first, Clone(src.data.second)}};
+}
+
+inline parser::PredicateFormula Clone(const parser::PredicateFormula& src) {
+  return {{src.data.first, Clone(src.data.second)}};
+}
+
+inline parser::UnaryFormula Clone(const parser::UnaryFormula& src) {
+  return std::visit([](auto&& a) { return parser::UnaryFormula{Clone(a)}; },
+                    src.data);
+}
+
+// Calls on_var for every variable term and on_bound for the variable of
+// every quantifier. Terms containing variables changed by on_var get their
+// info updated.
+template <class OnVar, class OnBound>
+struct VarsVisitor {
+  void operator()(parser::Term& term) {
+    if (term.IsVar()) {
+      on_var(term);
+    } else if (term.IsFunction()) {
+      term.ModifyFunction([this](parser::FunctionFormula& function) {
+        (*this)(function.data->second);
+      });
+    }
+  }
+
+  void operator()(parser::TermList& term_list) {
+    for (auto it = parser::TermListIt{&term_list}; it != parser::TermListIt{};
+         ++it) {
+      (*this)(*it);
+    }
+  }
+
+  void operator()(parser::PredicateFormula& pred) { (*this)(pred.data.second); }
+
+  void operator()(parser::ForallFormula& forall) {
+    on_bound(forall.data.first);
+    (*this)(forall.data.second);
+  }
+
+  void operator()(parser::ExistsFormula& exists) {
+    on_bound(exists.data.first);
+    (*this)(exists.data.second);
+  }
+
+  void operator()(parser::NotFormula& not_formula) {
+    (*this)(*not_formula.data);
+  }
+
+  void operator()(parser::BracketFormula& bracket) { (*this)(bracket.data); }
+
+  void operator()(parser::UnaryFormula& unary) {
+    std::visit([this](auto& a) { (*this)(a); }, unary.data);
+  }
+
+  void operator()(parser::ConjunctionPrimeFormula& conj_prime) {
+    if (auto ptr = std::get_if<0>(&conj_prime.data)) {
+      (*this)((*ptr)->first);
+      (*this)((*ptr)->second);
+    }
+  }
+
+  void operator()(parser::ConjunctionFormula& conj) {
+    (*this)(conj.data->first);
+    (*this)(conj.data->second);
+  }
+
+  void operator()(parser::DisjunctionPrimeFormula& disj_prime) {
+    if (auto ptr = std::get_if<0>(&disj_prime.data)) {
+      (*this)((*ptr)->first);
+      (*this)((*ptr)->second);
+    }
+  }
+
+  void operator()(parser::DisjunctionFormula& disj) {
+    (*this)(disj.data.first);
+    (*this)(disj.data.second);
+  }
+
+  void operator()(parser::ImplicationFormula& impl) {
+    if (auto disj = std::get_if<0>(&impl.data)) {
+      (*this)(*disj);
+    } else {
+      (*this)(std::get<1>(impl.data)->first);
+      (*this)(std::get<1>(impl.data)->second);
+    }
+  }
+
+  OnVar on_var;
+  OnBound on_bound;
+};
+
+template <class T, class OnVar, class OnBound>
+inline void VisitVars(T& where, OnVar on_var, OnBound on_bound) {
+  VarsVisitor<OnVar, OnBound>{std::move(on_var), std::move(on_bound)}(where);
+}
+
+// Renames every occurrence of what, the quantified ones included
+template <class T>
+inline void RenameVarInPlace(T& where, const std::string& what,
+                             const std::string& with) {
+  VisitVars(
+      where,
+      [&](parser::Term& var) {
+        if (var.Var() == what) {
+          var.SetVar(with);
+        }
+      },
+      [&](std::string& bound) {
+        if (bound == what) {
+          bound = with;
+        }
+      });
+}
+
+// Converts a clone of any formula node to a formula
+template <class T>
+inline parser::FolFormula CloneToFol(const T& src) {
+  if constexpr (std::is_constructible_v<decltype(parser::UnaryFormula::data),
+                                        T>) {
+    return parser::ToFol(parser::UnaryFormula{Clone(src)});
+  } else {
+    return parser::ToFol(Clone(src));
   }
-  return count;
 }
 
 template <class T>
 inline T RenameVar(T src, std::string with) {
-  auto str = parser::ToString(src.data.second);
-  ReplaceAll(str, src.data.first, with);
-  src.data.second = parser::Parse(lexer::Tokenize(str));
-  src.data.first = with;
+  RenameVarInPlace(src.data.second, src.data.first, with);
+  src.data.first = std::move(with);
   return src;
 }
 
-inline int cnt = 0;
 template <class T>
 inline T RenameVar(T src) {
-  ++cnt;
-  auto with = "vu" + std::to_string(cnt);
+  auto with = NormalizationContext::Current().FreshVar();
   return RenameVar(std::move(src), with);
 }
 
 template <class T>
 inline parser::Term CloneTerm(T&& src) {
-  auto str = parser::ToString(std::forward<T>(src));
-  auto generator = lexer::Tokenize(str);
-  auto it = generator.begin();
-  return parser::ParseTerm(it);
+  return Clone(src);
 }
 
 template <class T>
 inline parser::FolFormula CloneFol(T&& src) {
-  auto str = parser::ToString(std::forward<T>(src));
-  return parser::Parse(lexer::Tokenize(str));
+  return CloneToFol(src);
 }
 
 template <class T>
 inline parser::FolFormula ReplaceWithConst(T&& src, std::string what) {
-  auto str = parser::ToString(std::forward<T>(src));
-  ++cnt;
-  auto with = "cu" + std::to_string(cnt);
-  ReplaceAll(str, what, with);
-  return parser::Parse(lexer::Tokenize(str));
+  auto res = CloneToFol(src);
+  const auto with = NormalizationContext::Current().FreshConst();
+  VisitVars(
+      res,
+      [&](parser::Term& var) {
+        if (var.Var() == what) {
+          var = parser::Term{lexer::Constant{std::string_view{with}}};
+        }
+      },
+      [](std::string&) {});
+  return res;
 }
 
 template <class T>
-inline parser::FolFormula Replace(T&& src, std::string what) {
-  auto str = parser::ToString(std::forward<T>(src));
-  ++cnt;
-  auto with = "vu" + std::to_string(cnt);
-  ReplaceAll(str, what, with);
-  return parser::Parse(lexer::Tokenize(str));
+inline parser::FolFormula Replace(T&& src, std::string what, std::string with) {
+  auto res = CloneToFol(src);
+  RenameVarInPlace(res, what, with);
+  return res;
 }
 
 template <class T>
-inline parser::FolFormula Replace(T&& src, std::string what, std::string with) {
-  auto str = parser::ToString(std::forward<T>(src));
-  ReplaceAll(str, what, with);
-  return parser::Parse(lexer::Tokenize(str));
+inline parser::FolFormula Replace(T&& src, std::string what) {
+  return Replace(std::forward<T>(src), std::move(what),
+                 NormalizationContext::Current().FreshVar());
 }
 
 inline void ReplaceTerm(parser::ImplicationFormula& where,
@@ -176,10 +377,12 @@ inline void ReplaceTerm(parser::Term& where, const parser::Term& from,
   }
 
   if (where.IsFunction()) {
-    for (auto it = parser::FunctionTermsIt(where.Function());
-         it != parser::TermListIt{}; ++it) {
-      ReplaceTerm(*it, from, to);
-    }
+    where.ModifyFunction([&](parser::FunctionFormula& function) {
+      for (auto it = parser::FunctionTermsIt(function);
+           it != parser::TermListIt{}; ++it) {
+        ReplaceTerm(*it, from, to);
+      }
+    });
   }
 }
 
@@ -191,13 +394,13 @@ inline void ReplaceTermVar(auto& where, const std::string& from,
 }
 
 inline std::string UniqFunName() {
-  static int cnt = 0;
-  return "funiq" + std::to_string(cnt++);
+  return NormalizationContext::Current().FreshFunction();
 }
 
 inline parser::FolFormula RenameVar(parser::FolFormula src, std::string what,
                                     std::string with) {
-  return Replace(src, what, with);
+  RenameVarInPlace(src, what, with);
+  return src;
 }
 }  // namespace fol::transform
 
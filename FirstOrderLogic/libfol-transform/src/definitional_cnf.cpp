@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <libfol-transform/definitional_cnf.hpp>
+#include <libfol-transform/normalization_context.hpp>
+#include <libfol-transform/replace.hpp>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace fol::transform {
+namespace {
+// Quantifier-free formula in negation normal form with flattened and and or
+struct Nnf {
+  enum class Kind { LITERAL, AND, OR };
+
+  Kind kind;
+  std::optional<parser::UnaryFormula> literal;
+  std::vector<Nnf> children;
+};
+
+using Literals = std::vector<parser::UnaryFormula>;
+using Clauses = std::vector<Literals>;
+
+struct Unsupported {};
+
+const parser::UnaryFormula* AsUnary(const parser::FolFormula& formula) {
+  auto disj = std::get_if<parser::DisjunctionFormula>(&formula.data);
+  if (!disj || !std::holds_alternative<lexer::EPS>(disj->data.second.data)) {
+    return nullptr;
+  }
+  auto& conj = *disj->data.first.data;
+  if (!std::holds_alternative<lexer::EPS>(conj.second.data)) {
+    return nullptr;
+  }
+  return &conj.first;
+}
+
+void Append(Nnf& parent, Nnf child) {
+  if (child.kind == parent.kind) {
+    for (auto& grandchild : child.children) {
+      parent.children.push_back(std::move(grandchild));
+    }
+  } else {
+    parent.children.push_back(std::move(child));
+  }
+}
+
+Nnf Collapse(Nnf node) {
+  if (node.children.size() == 1) {
+    return std::move(node.children.front());
+  }
+  return node;
+}
+
+Nnf FromFol(const parser::FolFormula& formula);
+
+Nnf Literal(parser::UnaryFormula literal) {
+  return {Nnf::Kind::LITERAL, std::move(literal), {}};
+}
+
+Nnf FromUnary(const parser::UnaryFormula& unary) {
+  if (std::holds_alternative<parser::PredicateFormula>(unary.data)) {
+    return Literal(Clone(unary));
+  }
+  if (auto bracket = std::get_if<parser::BracketFormula>(&unary.data)) {
+    return FromFol(bracket->data);
+  }
+  if (auto not_formula = std::get_if<parser::NotFormula>(&unary.data)) {
+    auto inner = FromUnary(*not_formula->data);
+    if (inner.kind != Nnf::Kind::LITERAL) {
+      throw Unsupported{};
+    }
+    if (auto pred = std::get_if<parser::NotFormula>(&inner.literal->data)) {
+      return Literal(std::move(*pred->data));
+    }
+    return Literal(parser::MakeNot(std::move(*inner.literal)));
+  }
+  throw Unsupported{};
+}
+
+Nnf FromConj(const parser::ConjunctionFormula& conj) {
+  Nnf res{Nnf::Kind::AND, std::nullopt, {}};
+  Append(res, FromUnary(conj.data->first));
+  for (auto* tail = &conj.data->second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<0>(tail->data);
+    Append(res, FromUnary(next.first));
+    tail = &next.second;
+  }
+  return Collapse(std::move(res));
+}
+
+Nnf FromFol(const parser::FolFormula& formula) {
+  auto disj = std::get_if<parser::DisjunctionFormula>(&formula.data);
+  if (!disj) {
+    throw Unsupported{};
+  }
+
+  Nnf res{Nnf::Kind::OR, std::nullopt, {}};
+  Append(res, FromConj(disj->data.first));
+  for (auto* tail = &disj->data.second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<0>(tail->data);
+    Append(res, FromConj(next.first));
+    tail = &next.second;
+  }
+  return Collapse(std::move(res));
+}
+
+// Clauses of the distributed CNF, saturated at limit + 1
+std::size_t Estimate(const Nnf& node, std::size_t limit) {
+  if (node.kind == Nnf::Kind::LITERAL) {
+    return 1;
+  }
+
+  std::size_t res = node.kind == Nnf::Kind::AND ? 0 : 1;
+  for (auto& child : node.children) {
+    auto count = Estimate(child, limit);
+    res = node.kind == Nnf::Kind::AND ? res + count
+          : count > limit / res       ? limit + 1
+                                      : res * count;
+    res = std::min(res, limit + 1);
+  }
+  return res;
+}
+
+class Clausifier {
+ public:
+  explicit Clausifier(std::size_t max_clauses) : max_clauses_(max_clauses) {}
+
+  Clauses Clausify(Nnf node) {
+    Clauses res;
+    switch (node.kind) {
+      case Nnf::Kind::LITERAL:
+        res.emplace_back().push_back(std::move(*node.literal));
+        return res;
+      case Nnf::Kind::AND:
+        for (auto& child : node.children) {
+          for (auto& clause : Clausify(std::move(child))) {
+            res.push_back(std::move(clause));
+          }
+        }
+        return res;
+      case Nnf::Kind::OR:
+        res.emplace_back();
+        for (auto& child : node.children) {
+          auto clauses = Clausify(std::move(child));
+          if (Exceeds(res, clauses) && clauses.size() > 1) {
+            clauses = Define(std::move(clauses));
+          }
+          if (Exceeds(res, clauses) && res.size() > 1) {
+            res = Define(std::move(res));
+          }
+          res = Product(res, clauses);
+        }
+        return res;
+    }
+    return res;
+  }
+
+  Clauses& definitions() { return definitions_; }
+
+ private:
+  bool Exceeds(const Clauses& lhs, const Clauses& rhs) const {
+    return lhs.size() * rhs.size() > max_clauses_;
+  }
+
+  // Adds ~pdef(vars) or C for every clause C and returns pdef(vars)
+  Clauses Define(Clauses clauses) {
+    std::vector<std::string> vars;
+    std::unordered_set<std::string> seen;
+    for (auto& clause : clauses) {
+      for (auto& literal : clause) {
+        VisitVars(
+            literal,
+            [&](parser::Term& var) {
+              if (seen.insert(var.Var()).second) {
+                vars.push_back(var.Var());
+              }
+            },
+            [](std::string&) {});
+      }
+    }
+
+    std::vector<parser::Term> args;
+    for (auto& var : vars) {
+      args.emplace_back(lexer::Variable{std::string_view{var}});
+    }
+    if (args.empty()) {
+      args.emplace_back(lexer::Constant{std::string_view{"cEMPTY"}});
+    }
+    parser::UnaryFormula atom = parser::PredicateFormula{
+        {lexer::Predicate{std::string_view{
+             NormalizationContext::Current().FreshPredicate()}},
+         parser::ToTermList(std::move(args))}};
+
+    for (auto& clause : clauses) {
+      clause.insert(clause.begin(), parser::MakeNot(Clone(atom)));
+      definitions_.push_back(std::move(clause));
+    }
+
+    Clauses res;
+    res.emplace_back().push_back(std::move(atom));
+    return res;
+  }
+
+  static Clauses Product(const Clauses& lhs, const Clauses& rhs) {
+    Clauses res;
+    res.reserve(lhs.size() * rhs.size());
+    for (auto& l : lhs) {
+      for (auto& r : rhs) {
+        auto& clause = res.emplace_back();
+        clause.reserve(l.size() + r.size());
+        for (auto& literal : l) {
+          clause.push_back(Clone(literal));
+        }
+        for (auto& literal : r) {
+          clause.push_back(Clone(literal));
+        }
+      }
+    }
+    return res;
+  }
+
+  std::size_t max_clauses_;
+  Clauses definitions_;
+};
+
+parser::UnaryFormula ToUnary(Literals literals) {
+  if (literals.size() == 1) {
+    return std::move(literals.front());
+  }
+
+  parser::DisjunctionPrimeFormula tail{lexer::EPS{}};
+  for (auto i = literals.size() - 1; i > 0; --i) {
+    tail = {std::make_unique<std::pair<parser::ConjunctionFormula,
+                                       parser::DisjunctionPrimeFormula>>(
+        parser::MakeConj(std::move(literals[i])), std::move(tail))};
+  }
+  return parser::MakeBrackets(parser::ToFol(parser::DisjunctionFormula{
+      parser::MakeConj(std::move(literals.front())), std::move(tail)}));
+}
+
+parser::FolFormula ToFol(Clauses clauses) {
+  parser::ConjunctionPrimeFormula tail{lexer::EPS{}};
+  for (auto i = clauses.size() - 1; i > 0; --i) {
+    tail = {std::make_unique<
+        std::pair<parser::UnaryFormula, parser::ConjunctionPrimeFormula>>(
+        ToUnary(std::move(clauses[i])), std::move(tail))};
+  }
+  return parser::ToFol(parser::ConjunctionFormula{
+      std::make_unique<
+          std::pair<parser::UnaryFormula, parser::ConjunctionPrimeFormula>>(
+          ToUnary(std::move(clauses.front())), std::move(tail))});
+}
+}  // namespace
+
+std::optional<parser::FolFormula> ToDefinitionalCNF(
+    const parser::FolFormula& formula, std::size_t max_clauses) {
+  // quantifier prefix, true for forall
+  std::vector<std::pair<bool, std::string>> prefix;
+  auto matrix = &formula;
+  while (auto unary = AsUnary(*matrix)) {
+    if (auto forall = std::get_if<parser::ForallFormula>(&unary->data)) {
+      prefix.emplace_back(true, forall->data.first);
+      matrix = &forall->data.second;
+    } else if (auto exists = std::get_if<parser::ExistsFormula>(&unary->data)) {
+      prefix.emplace_back(false, exists->data.first);
+      matrix = &exists->data.second;
+    } else if (auto bracket =
+                   std::get_if<parser::BracketFormula>(&unary->data)) {
+      matrix = &bracket->data;
+    } else {
+      break;
+    }
+  }
+
+  std::optional<Nnf> nnf;
+  try {
+    nnf = FromFol(*matrix);
+  } catch (const Unsupported&) {
+    return std::nullopt;
+  }
+  if (Estimate(*nnf, max_clauses) <= max_clauses) {
+    return std::nullopt;
+  }
+
+  Clausifier clausifier{max_clauses};
+  auto clauses = clausifier.Clausify(std::move(*nnf));
+  for (auto& definition : clausifier.definitions()) {
+    clauses.push_back(std::move(definition));
+  }
+
+  auto res = ToFol(std::move(clauses));
+  for (auto it = prefix.rbegin(); it != prefix.rend(); ++it) {
+    res = it->first ? parser::ToFol(parser::MakeForall(it->second,
+                                                       std::move(res)))
+                    : parser::ToFol(parser::MakeExists(it->second,
+                                                       std::move(res)));
+  }
+  return res;
+}
+}  // namespace fol::transform
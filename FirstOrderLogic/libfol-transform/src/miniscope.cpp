@@ -0,0 +1,224 @@
+#include <libfol-transform/miniscope.hpp>
+#include <libfol-transform/replace.hpp>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace fol::transform {
+namespace {
+// Conservative, a variable bound inside counts as occurring
+template <class T>
+bool Occurs(T& where, const std::string& var) {
+  bool occurs = false;
+  VisitVars(
+      where, [&](parser::Term& term) { occurs |= term.Var() == var; },
+      [](std::string&) {});
+  return occurs;
+}
+
+std::vector<parser::ConjunctionFormula> Disjuncts(
+    parser::DisjunctionFormula disj) {
+  std::vector<parser::ConjunctionFormula> res;
+  res.push_back(std::move(disj.data.first));
+  for (auto tail = std::move(disj.data.second);
+       !std::holds_alternative<lexer::EPS>(tail.data);) {
+    auto next = std::move(*std::get<0>(tail.data));
+    res.push_back(std::move(next.first));
+    tail = std::move(next.second);
+  }
+  return res;
+}
+
+std::vector<parser::UnaryFormula> Conjuncts(parser::ConjunctionFormula conj) {
+  std::vector<parser::UnaryFormula> res;
+  res.push_back(std::move(conj.data->first));
+  for (auto tail = std::move(conj.data->second);
+       !std::holds_alternative<lexer::EPS>(tail.data);) {
+    auto next = std::move(*std::get<0>(tail.data));
+    res.push_back(std::move(next.first));
+    tail = std::move(next.second);
+  }
+  return res;
+}
+
+parser::UnaryFormula ToUnary(std::vector<parser::ConjunctionFormula> items) {
+  auto res = parser::MakeDisj(std::move(items.back()));
+  for (auto it = items.rbegin() + 1; it != items.rend(); ++it) {
+    res = parser::MakeDisj(std::move(*it), std::move(res));
+  }
+  return parser::MakeBrackets(parser::ToFol(std::move(res)));
+}
+
+parser::ConjunctionFormula ToConj(std::vector<parser::UnaryFormula> items) {
+  auto res = parser::MakeConj(std::move(items.back()));
+  for (auto it = items.rbegin() + 1; it != items.rend(); ++it) {
+    res = parser::MakeConj(std::move(*it), std::move(res));
+  }
+  return res;
+}
+
+parser::UnaryFormula ToUnary(std::vector<parser::UnaryFormula> items) {
+  if (items.size() == 1) {
+    return std::move(items.front());
+  }
+  return parser::MakeBrackets(
+      parser::ToFol(parser::MakeDisj(ToConj(std::move(items)))));
+}
+
+parser::UnaryFormula Quantify(bool forall, const std::string& var,
+                              parser::ImplicationFormula body) {
+  if (forall) {
+    return parser::MakeForall(var, std::move(body));
+  }
+  return parser::MakeExists(var, std::move(body));
+}
+
+parser::UnaryFormula Push(bool forall, const std::string& var,
+                          parser::ImplicationFormula body);
+
+// Quantifies every item var occurs in apart
+template <class Item>
+void Distribute(bool forall, const std::string& var,
+                std::vector<Item>& items) {
+  for (auto& item : items) {
+    if (!Occurs(item, var)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<Item, parser::UnaryFormula>) {
+      item = Push(forall, var, parser::ToFol(std::move(item)));
+    } else {
+      item =
+          parser::MakeConj(Push(forall, var, parser::ToFol(std::move(item))));
+    }
+  }
+}
+
+// Quantifies the items var occurs in together, in place of the first one
+template <class Item>
+void Group(bool forall, const std::string& var, std::vector<Item>& items) {
+  std::vector<Item> inside;
+  std::vector<Item> outside;
+  std::size_t position = 0;
+  for (auto& item : items) {
+    if (Occurs(item, var)) {
+      if (inside.empty()) {
+        position = outside.size();
+      }
+      inside.push_back(std::move(item));
+    } else {
+      outside.push_back(std::move(item));
+    }
+  }
+  items = std::move(outside);
+  if (inside.empty()) {
+    return;
+  }
+
+  auto quantified =
+      inside.size() == 1
+          ? Push(forall, var, parser::ToFol(std::move(inside.front())))
+          : Quantify(forall, var, parser::ToFol(ToUnary(std::move(inside))));
+  if constexpr (std::is_same_v<Item, parser::UnaryFormula>) {
+    items.insert(items.begin() + position, std::move(quantified));
+  } else {
+    items.insert(items.begin() + position,
+                 parser::MakeConj(std::move(quantified)));
+  }
+}
+
+// Q var . body with the quantifier pushed inward, body is miniscoped
+parser::UnaryFormula Push(bool forall, const std::string& var,
+                          parser::ImplicationFormula body) {
+  if (!Occurs(body, var)) {
+    return parser::MakeBrackets(std::move(body));
+  }
+  if (!std::holds_alternative<parser::DisjunctionFormula>(body.data)) {
+    return Quantify(forall, var, std::move(body));
+  }
+
+  auto disjuncts =
+      Disjuncts(std::move(std::get<parser::DisjunctionFormula>(body.data)));
+  if (disjuncts.size() > 1) {
+    if (forall) {
+      Group(forall, var, disjuncts);
+    } else {
+      Distribute(forall, var, disjuncts);
+    }
+    return ToUnary(std::move(disjuncts));
+  }
+
+  auto conjuncts = Conjuncts(std::move(disjuncts.front()));
+  if (conjuncts.size() > 1) {
+    if (forall) {
+      Distribute(forall, var, conjuncts);
+    } else {
+      Group(forall, var, conjuncts);
+    }
+    return ToUnary(std::move(conjuncts));
+  }
+
+  auto& unary = conjuncts.front();
+  if (auto bracket = std::get_if<parser::BracketFormula>(&unary.data)) {
+    return Push(forall, var, std::move(bracket->data));
+  }
+  return Quantify(forall, var, parser::ToFol(std::move(unary)));
+}
+
+void MiniscopeInPlace(parser::ImplicationFormula& formula);
+
+void MiniscopeInPlace(parser::UnaryFormula& unary) {
+  if (auto forall = std::get_if<parser::ForallFormula>(&unary.data)) {
+    MiniscopeInPlace(forall->data.second);
+    auto [var, body] = std::move(forall->data);
+    unary = Push(true, var, std::move(body));
+  } else if (auto exists = std::get_if<parser::ExistsFormula>(&unary.data)) {
+    MiniscopeInPlace(exists->data.second);
+    auto [var, body] = std::move(exists->data);
+    unary = Push(false, var, std::move(body));
+  } else if (auto not_formula =
+                 std::get_if<parser::NotFormula>(&unary.data)) {
+    MiniscopeInPlace(*not_formula->data);
+  } else if (auto bracket =
+                 std::get_if<parser::BracketFormula>(&unary.data)) {
+    MiniscopeInPlace(bracket->data);
+  }
+}
+
+void MiniscopeInPlace(parser::ConjunctionFormula& conj) {
+  MiniscopeInPlace(conj.data->first);
+  for (auto* tail = &conj.data->second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<0>(tail->data);
+    MiniscopeInPlace(next.first);
+    tail = &next.second;
+  }
+}
+
+void MiniscopeInPlace(parser::DisjunctionFormula& disj) {
+  MiniscopeInPlace(disj.data.first);
+  for (auto* tail = &disj.data.second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<0>(tail->data);
+    MiniscopeInPlace(next.first);
+    tail = &next.second;
+  }
+}
+
+void MiniscopeInPlace(parser::ImplicationFormula& formula) {
+  if (auto disj = std::get_if<parser::DisjunctionFormula>(&formula.data)) {
+    MiniscopeInPlace(*disj);
+  } else {
+    auto& pair = *std::get<1>(formula.data);
+    MiniscopeInPlace(pair.first);
+    MiniscopeInPlace(pair.second);
+  }
+}
+}  // namespace
+
+parser::FolFormula Miniscope(parser::FolFormula formula) {
+  MiniscopeInPlace(formula);
+  return formula;
+}
+}  // namespace fol::transform
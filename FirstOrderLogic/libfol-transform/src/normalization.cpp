@@ -1,17 +1,16 @@
+#include <algorithm>
+#include <details/utils/parallel.hpp>
+#include <libfol-matcher/rule_set.hpp>
+#include <libfol-matcher/view_matcher.hpp>
+#include <libfol-transform/definitional_cnf.hpp>
+#include <libfol-transform/miniscope.hpp>
 #include <libfol-transform/normalization.hpp>
 #include <libfol-transform/normalized_formula.hpp>
-#include <numeric>
+#include <libfol-transform/prenex.hpp>
 
 namespace fol::transform {
 parser::FolFormula Normalize(parser::FolFormula formula);
 
-bool IsNoQuantifiers(const parser::FolFormula &formula) {
-  auto str = ToString(formula);
-
-  return (str.find("@") == std::string::npos) &&
-         (str.find("?") == std::string::npos);
-}
-
 template <class T>
 bool IsAllDisj(const T &formula) {
   auto str = ToString(formula);
@@ -41,10 +40,6 @@ parser::DisjunctionFormula DeleteUselessBrackets(
 
 parser::FolFormula DeleteUselessBrackets(parser::FolFormula formula);
 
-parser::FolFormula Copy(const parser::FolFormula &formula) {
-  return parser::Parse(lexer::Tokenize(parser::ToString(formula)));
-}
-
 auto Match(auto matcher, parser::FolFormula formula) {
   matcher.match(std::move(formula));
   return std::move(matcher.formula.value());
@@ -125,622 +120,120 @@ parser::ImplicationFormula DropAllBracketsInNot(
   return formula;
 }
 
-// (Q vx . F[vx]) or G = (Q uc . F[uc] or G)
-parser::ImplicationFormula QuantifiersToCNF1(
-    parser::ImplicationFormula formula) {
-  // G or (@ vx . F[vx]) = @ uc . F[uc] or G
-  if (matcher::check::Disj(matcher::check::Anything(),
-                           matcher::check::Forall())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Disj(matcher::RefImpl(g), matcher::RefForall(forall_f))
-        .match(std::move(formula));
-
-    forall_f = RenameVar(std::move(forall_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeForall(
-        forall_f.value().data.first,
-        {!std::move(forall_f.value().data.second) || !std::move(g.value())})))};
-  }
-
-  // G or (? vx . F[vx]) = ? uc . F[uc] or G
-  if (matcher::check::Disj(matcher::check::Anything(),
-                           matcher::check::Exists())(formula)) {
-    std::optional<parser::ExistsFormula> exists_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Disj(matcher::RefImpl(g), matcher::RefExists(exists_f))
-        .match(std::move(formula));
-
-    exists_f = RenameVar(std::move(exists_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        exists_f.value().data.first,
-        {!std::move(exists_f.value().data.second) || !std::move(g.value())})))};
-  }
-
-  // (@ vx . F[vx]) or G = @ uc . F[uc] or G
-  if (matcher::check::Disj(matcher::check::Forall(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Disj(matcher::RefForall(forall_f), matcher::RefImpl(g))
-        .match(std::move(formula));
-
-    forall_f = RenameVar(std::move(forall_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeForall(
-        forall_f.value().data.first,
-        {!std::move(forall_f.value().data.second) || !std::move(g.value())})))};
-  }
-
-  // (? vx . F[vx]) or G = ? uc . F[uc] or G
-  if (matcher::check::Disj(matcher::check::Exists(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ExistsFormula> exists_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Disj(matcher::RefExists(exists_f), matcher::RefImpl(g))
-        .match(std::move(formula));
-
-    exists_f = RenameVar(std::move(exists_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        exists_f.value().data.first,
-        {!std::move(exists_f.value().data.second) || !std::move(g.value())})))};
-  }
-
-  return formula;
-}
-
-// (Q vx . F[vx]) and G = (Q uc . F[uc] and G)
-parser::ImplicationFormula QuantifiersToCNF2(
-    parser::ImplicationFormula formula) {
-  // G and (@ vx . F[vx]) = @ uc . F[uc] and G
-  if (matcher::check::Conj(matcher::check::Anything(),
-                           matcher::check::Forall())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Conj(matcher::RefImpl(g), matcher::RefForall(forall_f))
-        .match(std::move(formula));
-
-    forall_f = RenameVar(std::move(forall_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeForall(
-        forall_f.value().data.first,
-        {!std::move(forall_f.value().data.second) && !std::move(g.value())})))};
-  }
-
-  // G and (? vx . F[vx]) = ? uc . F[uc] and G
-  if (matcher::check::Conj(matcher::check::Anything(),
-                           matcher::check::Exists())(formula)) {
-    std::optional<parser::ExistsFormula> exists_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Conj(matcher::RefImpl(g), matcher::RefExists(exists_f))
-        .match(std::move(formula));
-
-    exists_f = RenameVar(std::move(exists_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        exists_f.value().data.first,
-        {!std::move(exists_f.value().data.second) && !std::move(g.value())})))};
-  }
-
-  // (@ vx . F[vx]) and G = @ uc . F[uc] and G
-  if (matcher::check::Conj(matcher::check::Forall(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Conj(matcher::RefForall(forall_f), matcher::RefImpl(g))
-        .match(std::move(formula));
-
-    forall_f = RenameVar(std::move(forall_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeForall(
-        forall_f.value().data.first,
-        {!std::move(forall_f.value().data.second) && !std::move(g.value())})))};
-  }
-
-  // (? vx . F[vx]) and G = ? uc . F[uc] and G
-  if (matcher::check::Conj(matcher::check::Exists(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ExistsFormula> exists_f;
-    std::optional<parser::FolFormula> g;
-    matcher::Conj(matcher::RefExists(exists_f), matcher::RefImpl(g))
-        .match(std::move(formula));
-
-    exists_f = RenameVar(std::move(exists_f).value());
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        exists_f.value().data.first,
-        {!std::move(exists_f.value().data.second) && !std::move(g.value())})))};
-  }
-
-  return formula;
-}
-
-// (@ vx . F[vx]) and (@ vx . H[vx]) = (@ vx . F[vx] and H[vx])
-parser::ImplicationFormula QuantifiersToCNF3(
-    parser::ImplicationFormula formula) {
-  // (@ vx . F[vx]) and (@ vx . H[vx]) = @ vx . F[vx] or H[vx]
-  if (matcher::check::Conj(matcher::check::Forall(),
-                           matcher::check::Forall())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::ForallFormula> forall_h;
-
-    matcher::Conj(matcher::RefForall(forall_f), matcher::RefForall(forall_h))
-        .match(std::move(formula));
-
-    forall_h =
-        RenameVar(std::move(forall_h.value()), forall_f.value().data.first);
-
-    return {parser::MakeDisj(parser::MakeConj(
-        parser::MakeForall(forall_f.value().data.first,
-                           {!std::move(forall_f.value().data.second) &&
-                            !std::move(forall_h.value().data.second)})))};
-  }
-
-  return formula;
-}
-
-// (? vx . F[vx]) or (? vx . H[vx]) = ? vx . F[vx] or H[vx]
-parser::ImplicationFormula QuantifiersToCNF4(
-    parser::ImplicationFormula formula) {
-  // (? vx . F[vx]) or (? vx . H[vx]) = ? vx . F[vx] or H[vx]
-  if (matcher::check::Disj(matcher::check::Exists(),
-                           matcher::check::Exists())(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    std::optional<parser::ExistsFormula> forall_h;
-
-    matcher::Disj(matcher::RefExists(forall_f), matcher::RefExists(forall_h))
-        .match(std::move(formula));
-
-    forall_h =
-        RenameVar(std::move(forall_h.value()), forall_f.value().data.first);
-
-    return {parser::MakeDisj(parser::MakeConj(
-        parser::MakeExists(forall_f.value().data.first,
-                           {!std::move(forall_f.value().data.second) ||
-                            !std::move(forall_h.value().data.second)})))};
-  }
-
-  return formula;
-}
-
-// (Q1 vx . F[vx]) and (Q2 vx . H[vx]) = Q1 vx . Q2 uc . F[vx] and H[uc]
-parser::ImplicationFormula QuantifiersToCNF6(
-    parser::ImplicationFormula formula) {
-  // (? vx . F[vx]) and (? vx . H[vx]) = ? ucc . ? uc . F[ucc] and H[uc]
-  if (matcher::check::Conj(matcher::check::Exists(),
-                           matcher::check::Exists())(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    std::optional<parser::ExistsFormula> forall_h;
-
-    matcher::Conj(matcher::RefExists(forall_f), matcher::RefExists(forall_h))
-        .match(std::move(formula));
-
-    forall_f = RenameVar(std::move(forall_f.value()));
-    forall_h = RenameVar(std::move(forall_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeExists(forall_h.value().data.first,
-                               {!std::move(forall_f.value().data.second) &&
-                                !std::move(forall_h.value().data.second)})))};
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        forall_f.value().data.first, std::move(inner_forall))))};
-  }
-
-  // (? vx . F[vx]) and (@ vx . H[vx]) = ? uc . @ uc . F[ucc] and H[uc]
-  if (matcher::check::Conj(matcher::check::Exists(),
-                           matcher::check::Forall())(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    std::optional<parser::ForallFormula> forall_h;
-
-    matcher::Conj(matcher::RefExists(forall_f), matcher::RefForall(forall_h))
-        .match(std::move(formula));
-
-    forall_f = RenameVar(std::move(forall_f.value()));
-    forall_h = RenameVar(std::move(forall_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeForall(forall_h.value().data.first,
-                               {!std::move(forall_f.value().data.second) &&
-                                !std::move(forall_h.value().data.second)})))};
-
-    return parser::ToFol(parser::MakeExists(forall_f.value().data.first,
-                                            std::move(inner_forall)));
-  }
-
-  // (@ vx . F[vx]) and (? vx . H[vx]) = ? uc . @ vx . F[vx] and H[uc]
-  if (matcher::check::Conj(matcher::check::Forall(),
-                           matcher::check::Exists())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::ExistsFormula> forall_h;
-
-    matcher::Conj(matcher::RefForall(forall_f), matcher::RefExists(forall_h))
-        .match(std::move(formula));
-
-    forall_h = RenameVar(std::move(forall_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeForall(forall_h.value().data.first,
-                               {!std::move(forall_f.value().data.second) &&
-                                !std::move(forall_h.value().data.second)})))};
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        forall_f.value().data.first, std::move(inner_forall))))};
-  }
-
-  // (@ vx . F[vx]) and (@ vx . H[vx]) = @ vx . @ uc . F[vx] and H[uc]
-  if (matcher::check::Conj(matcher::check::Forall(),
-                           matcher::check::Forall())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::ForallFormula> forall_h;
-
-    matcher::Conj(matcher::RefForall(forall_f), matcher::RefForall(forall_h))
-        .match(std::move(formula));
-
-    forall_h = RenameVar(std::move(forall_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeForall(forall_h.value().data.first,
-                               {!std::move(forall_f.value().data.second) &&
-                                !std::move(forall_h.value().data.second)})))};
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeForall(
-        forall_f.value().data.first, std::move(inner_forall))))};
-  }
-
-  return formula;
-}
-
-// (Q1 vx . F[vx]) or (Q2 vx . H[vx]) = Q1 vx . Q2 uc . F[vx] or H[uc]
-parser::ImplicationFormula QuantifiersToCNF5(
-    parser::ImplicationFormula formula) {
-  // (? vx . F[vx]) or (? vx . H[vx]) = ? vx . ? uc . F[vx] or H[uc]
-  if (matcher::check::Disj(matcher::check::Exists(),
-                           matcher::check::Exists())(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    std::optional<parser::ExistsFormula> forall_h;
-
-    matcher::Disj(matcher::RefExists(forall_f), matcher::RefExists(forall_h))
-        .match(std::move(formula));
-
-    forall_h = RenameVar(std::move(forall_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeExists(forall_h.value().data.first,
-                               {!std::move(forall_f.value().data.second) ||
-                                !std::move(forall_h.value().data.second)})))};
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        forall_f.value().data.first, std::move(inner_forall))))};
-  }
-
-  // (? vx . F[vx]) or (@ vx . H[vx]) = ? vx . @ uc . F[vx] or H[uc]
-  if (matcher::check::Disj(matcher::check::Exists(),
-                           matcher::check::Forall())(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    std::optional<parser::ForallFormula> forall_h;
-
-    matcher::Disj(matcher::RefExists(forall_f), matcher::RefForall(forall_h))
-        .match(std::move(formula));
-
-    forall_h = RenameVar(std::move(forall_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeForall(forall_h.value().data.first,
-                               {!std::move(forall_f.value().data.second) ||
-                                !std::move(forall_h.value().data.second)})))};
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        forall_f.value().data.first, std::move(inner_forall))))};
-  }
-
-  // (@ vx . F[vx]) or (? vx . H[vx]) = ? uc . @ vx . F[vx] or H[uc]
-  if (matcher::check::Disj(matcher::check::Forall(),
-                           matcher::check::Exists())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::ExistsFormula> exists_h;
-
-    matcher::Disj(matcher::RefForall(forall_f), matcher::RefExists(exists_h))
-        .match(std::move(formula));
-
-    exists_h = RenameVar(std::move(exists_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeForall(forall_f.value().data.first,
-                               {!std::move(forall_f.value().data.second) ||
-                                !std::move(exists_h.value().data.second)})))};
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeExists(
-        exists_h.value().data.first, std::move(inner_forall))))};
-  }
-
-  // (@ vx . F[vx]) or (@ vx . H[vx]) = @ vx . @ uc . F[vx] or H[uc]
-  if (matcher::check::Disj(matcher::check::Forall(),
-                           matcher::check::Forall())(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    std::optional<parser::ForallFormula> forall_h;
-
-    matcher::Disj(matcher::RefForall(forall_f), matcher::RefForall(forall_h))
-        .match(std::move(formula));
-
-    forall_h = RenameVar(std::move(forall_h.value()));
-
-    parser::ImplicationFormula inner_forall = {
-        parser::MakeDisj(parser::MakeConj(
-            parser::MakeForall(forall_h.value().data.first,
-                               {!std::move(forall_f.value().data.second) ||
-                                !std::move(forall_h.value().data.second)})))};
-
-    return {parser::MakeDisj(parser::MakeConj(parser::MakeForall(
-        forall_f.value().data.first, std::move(inner_forall))))};
-  }
-
-  return formula;
-}
-
-parser::ImplicationFormula NormalizeQuantifiersStep(
-    parser::ImplicationFormula formula) {
-  formula = QuantifiersToCNF3(std::move(formula));
-  formula = QuantifiersToCNF4(std::move(formula));
-
-  formula = QuantifiersToCNF5(std::move(formula));
-  formula = QuantifiersToCNF6(std::move(formula));
-
-  formula = QuantifiersToCNF1(std::move(formula));
-  formula = QuantifiersToCNF2(std::move(formula));
-
-  return formula;
-}
-
-parser::ImplicationFormula NormalizeQuantifiers(
-    parser::ImplicationFormula formula) {
-  formula = DropAllOutBrackets(std::move(formula));
-  formula = DropAllBracketsInNot(std::move(formula));
-
-  if (IsNoQuantifiers(formula)) {
-    return formula;
-  }
-
-  formula = NormalizeQuantifiersStep(std::move(formula));
-
-  if (matcher::check::Forall()(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    matcher::RefForall(forall_f).match(std::move(formula));
-    return parser::ToFol(parser::MakeForall(
-        forall_f.value().data.first,
-        NormalizeQuantifiers(std::move(forall_f.value().data.second))));
-  }
-
-  if (matcher::check::Exists()(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    matcher::RefExists(forall_f).match(std::move(formula));
-    return parser::ToFol(parser::MakeExists(
-        forall_f.value().data.first,
-        NormalizeQuantifiers(std::move(forall_f.value().data.second))));
-  }
-
-  if (matcher::check::Disj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::FolFormula> fol_lhs;
-    std::optional<parser::FolFormula> fol_rhs;
-    matcher::Disj(matcher::RefImpl(fol_lhs), matcher::RefImpl(fol_rhs))
-        .match(std::move(formula));
-
-    return NormalizeQuantifiers(
-        parser::ToFol(!NormalizeQuantifiers(std::move(fol_lhs.value())) ||
-                      !NormalizeQuantifiers(std::move(fol_rhs.value()))));
-  }
-
-  if (matcher::check::Conj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::FolFormula> fol_lhs;
-    std::optional<parser::FolFormula> fol_rhs;
-    matcher::Conj(matcher::RefImpl(fol_lhs), matcher::RefImpl(fol_rhs))
-        .match(std::move(formula));
-
-    return NormalizeQuantifiers(
-        parser::ToFol(!NormalizeQuantifiers(std::move(fol_lhs.value())) &&
-                      !NormalizeQuantifiers(std::move(fol_rhs.value()))));
-  }
-
-  return formula;
-}
-
 parser::ImplicationFormula RemoveImplication(
     parser::ImplicationFormula formula) {
+  namespace view = matcher::view;
   formula = DropAllOutBrackets(std::move(formula));
   formula = DropAllBracketsInNot(std::move(formula));
-  // F -> G = (~ F) or (G)
-  if (matcher::check::Impl(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ImplicationFormula> impl_f;
-    std::optional<parser::ImplicationFormula> impl;
-
-    matcher::Impl(matcher::RefImpl(impl_f), matcher::RefImpl(impl))
-        .match(std::move(formula));
-
-    parser::ImplicationFormula disj_t = RemoveImplication(
-        {~!std::move(impl_f.value()) || !std::move(impl.value())});
-
-    return disj_t;
-  }
-
-  if (matcher::check::Forall()(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    matcher::RefForall(forall_f).match(std::move(formula));
-    return parser::ToFol(parser::MakeForall(
-        forall_f.value().data.first,
-        RemoveImplication(std::move(forall_f.value().data.second))));
-  }
-
-  if (matcher::check::Exists()(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    matcher::RefExists(forall_f).match(std::move(formula));
-    return parser::ToFol(parser::MakeExists(
-        forall_f.value().data.first,
-        RemoveImplication(std::move(forall_f.value().data.second))));
-  }
-
-  if (matcher::check::Disj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::FolFormula> fol_lhs;
-    std::optional<parser::FolFormula> fol_rhs;
-    matcher::Disj(matcher::RefImpl(fol_lhs), matcher::RefImpl(fol_rhs))
-        .match(std::move(formula));
 
-    return parser::ToFol(!RemoveImplication(std::move(fol_lhs.value())) ||
-                         !RemoveImplication(std::move(fol_rhs.value())));
+  std::optional<view::FormulaView> lhs;
+  std::optional<view::FormulaView> rhs;
+  std::optional<std::string> var;
+
+  auto rules = view::RuleSet{
+      // F -> G = (~ F) or (G)
+      view::On(view::Impl(view::Bind(lhs), view::Bind(rhs)),
+               [&] {
+                 return RemoveImplication({~!lhs->Take() || !rhs->Take()});
+               }),
+      view::On(view::Forall(view::Bind(var), view::Bind(rhs)),
+               [&] {
+                 return parser::ToFol(
+                     parser::MakeForall(*var, RemoveImplication(rhs->Take())));
+               }),
+      view::On(view::Exists(view::Bind(var), view::Bind(rhs)),
+               [&] {
+                 return parser::ToFol(
+                     parser::MakeExists(*var, RemoveImplication(rhs->Take())));
+               }),
+      view::On(view::Disj(view::Bind(lhs), view::Bind(rhs)),
+               [&] {
+                 return parser::ToFol(!RemoveImplication(lhs->Take()) ||
+                                      !RemoveImplication(rhs->Take()));
+               }),
+      view::On(view::Conj(view::Bind(lhs), view::Bind(rhs)),
+               [&] {
+                 return parser::ToFol(!RemoveImplication(lhs->Take()) &&
+                                      !RemoveImplication(rhs->Take()));
+               }),
+      view::On(view::Not(view::Bind(rhs)), [&] {
+        return parser::ToFol(~!RemoveImplication(rhs->Take()));
+      })};
+
+  if (auto res = rules.Apply(view::FormulaView{&formula})) {
+    return std::move(*res);
   }
-
-  if (matcher::check::Conj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::FolFormula> fol_lhs;
-    std::optional<parser::FolFormula> fol_rhs;
-    matcher::Conj(matcher::RefImpl(fol_lhs), matcher::RefImpl(fol_rhs))
-        .match(std::move(formula));
-
-    return parser::ToFol(!RemoveImplication(std::move(fol_lhs.value())) &&
-                         !RemoveImplication(std::move(fol_rhs.value())));
-  }
-
-  if (matcher::check::Not()(formula)) {
-    std::optional<parser::FolFormula> fol;
-    matcher::Not(matcher::RefImpl(fol)).match(std::move(formula));
-    return parser::ToFol(~!RemoveImplication(std::move(fol.value())));
-  }
-
   return formula;
 }
 
 parser::ImplicationFormula MoveNegInner(parser::ImplicationFormula formula) {
+  namespace view = matcher::view;
   formula = DropAllOutBrackets(std::move(formula));
   formula = DropAllBracketsInNot(std::move(formula));
 
-  // ~(~F) = F
-  if (matcher::check::Not(matcher::check::Not())(formula)) {
-    std::optional<parser::ImplicationFormula> unary;
-    matcher::Not(matcher::Not(matcher::RefImpl(unary)))
-        .match(std::move(formula));
-
-    return MoveNegInner(std::move(unary.value()));
-  }
-
-  // ~(F or G) = ~F and ~G
-  if (matcher::check::Not(matcher::check::Disj(
-          matcher::check::Anything(), matcher::check::Anything()))(formula)) {
-    std::optional<parser::ImplicationFormula> impl_lhs;
-    std::optional<parser::ImplicationFormula> impl_rhs;
-
-    matcher::Not(matcher::Brackets(matcher::Disj(matcher::RefImpl(impl_lhs),
-                                                 matcher::RefImpl(impl_rhs))))
-        .match(std::move(formula));
-
-    auto conj =
-        MoveNegInner({!(matcher::UnaryToFol(~!std::move(impl_lhs.value()))) &&
-                      !(matcher::UnaryToFol(~!std::move(impl_rhs.value())))});
-
-    return conj;
-  }
-
-  // ~(F and G) = ~F or ~G
-  if (matcher::check::Not(matcher::check::Conj(
-          matcher::check::Anything(), matcher::check::Anything()))(formula)) {
-    std::optional<parser::ImplicationFormula> impl_lhs;
-    std::optional<parser::ImplicationFormula> impl_rhs;
-
-    matcher::Not(matcher::Brackets(matcher::Conj(matcher::RefImpl(impl_lhs),
-                                                 matcher::RefImpl(impl_rhs))))
-        .match(std::move(formula));
-
-    auto disj =
-        MoveNegInner({!(matcher::UnaryToFol(~!std::move(impl_lhs.value()))) ||
-                      !(matcher::UnaryToFol(~!std::move(impl_rhs.value())))});
-
-    return disj;
-  }
-
-  // ~(@ vx . F) = ? vx . ~F
-  if (matcher::check::Not(matcher::check::Forall())(formula)) {
-    std::optional<std::string> var;
-    std::optional<parser::ImplicationFormula> impl;
-    matcher::Not(matcher::Forall(matcher::RefName(var), matcher::RefImpl(impl)))
-        .match(std::move(formula));
-
-    lexer::Variable var_v;
-    var_v.base() = var.value();
-
-    return parser::Exists(
-        std::move(var_v),
-        MoveNegInner(matcher::UnaryToFol(~!std::move(impl.value()))));
-  }
-
-  // ~(? vx . F) = @ vx . ~F
-  if (matcher::check::Not(matcher::check::Exists())(formula)) {
-    std::optional<std::string> var;
-    std::optional<parser::ImplicationFormula> impl;
-    matcher::Not(matcher::Exists(matcher::RefName(var), matcher::RefImpl(impl)))
-        .match(std::move(formula));
-
-    lexer::Variable var_v;
-    var_v.base() = var.value();
-
-    return parser::ForAll(
-        std::move(var_v),
-        MoveNegInner(matcher::UnaryToFol(~!std::move(impl.value()))));
-  }
-
-  if (matcher::check::Forall()(formula)) {
-    std::optional<parser::ForallFormula> forall_f;
-    matcher::RefForall(forall_f).match(std::move(formula));
-    return parser::ToFol(parser::MakeForall(
-        forall_f.value().data.first,
-        MoveNegInner(std::move(forall_f.value().data.second))));
-  }
-
-  if (matcher::check::Exists()(formula)) {
-    std::optional<parser::ExistsFormula> forall_f;
-    matcher::RefExists(forall_f).match(std::move(formula));
-    return parser::ToFol(parser::MakeExists(
-        forall_f.value().data.first,
-        MoveNegInner(std::move(forall_f.value().data.second))));
+  std::optional<view::FormulaView> lhs;
+  std::optional<view::FormulaView> rhs;
+  std::optional<std::string> var;
+
+  auto rules = view::RuleSet{
+      // ~(~F) = F
+      view::On(view::Not(view::Not(view::Bind(rhs))),
+               [&] { return MoveNegInner(rhs->Take()); }),
+      // ~(F or G) = ~F and ~G
+      view::On(view::Not(view::Disj(view::Bind(lhs), view::Bind(rhs))),
+               [&] {
+                 return MoveNegInner(
+                     {!(matcher::UnaryToFol(~!lhs->Take())) &&
+                      !(matcher::UnaryToFol(~!rhs->Take()))});
+               }),
+      // ~(F and G) = ~F or ~G
+      view::On(view::Not(view::Conj(view::Bind(lhs), view::Bind(rhs))),
+               [&] {
+                 return MoveNegInner(
+                     {!(matcher::UnaryToFol(~!lhs->Take())) ||
+                      !(matcher::UnaryToFol(~!rhs->Take()))});
+               }),
+      // ~(@ vx . F) = ? vx . ~F
+      view::On(view::Not(view::Forall(view::Bind(var), view::Bind(rhs))),
+               [&] {
+                 return parser::ToFol(parser::MakeExists(
+                     *var, MoveNegInner(matcher::UnaryToFol(~!rhs->Take()))));
+               }),
+      // ~(? vx . F) = @ vx . ~F
+      view::On(view::Not(view::Exists(view::Bind(var), view::Bind(rhs))),
+               [&] {
+                 return parser::ToFol(parser::MakeForall(
+                     *var, MoveNegInner(matcher::UnaryToFol(~!rhs->Take()))));
+               }),
+      view::On(view::Forall(view::Bind(var), view::Bind(rhs)),
+               [&] {
+                 return parser::ToFol(
+                     parser::MakeForall(*var, MoveNegInner(rhs->Take())));
+               }),
+      view::On(view::Exists(view::Bind(var), view::Bind(rhs)),
+               [&] {
+                 return parser::ToFol(
+                     parser::MakeExists(*var, MoveNegInner(rhs->Take())));
+               }),
+      view::On(view::Disj(view::Bind(lhs), view::Bind(rhs)),
+               [&] {
+                 return parser::ToFol(!MoveNegInner(lhs->Take()) ||
+                                      !MoveNegInner(rhs->Take()));
+               }),
+      view::On(view::Conj(view::Bind(lhs), view::Bind(rhs)), [&] {
+        return parser::ToFol(!MoveNegInner(lhs->Take()) &&
+                             !MoveNegInner(rhs->Take()));
+      })};
+
+  if (auto res = rules.Apply(view::FormulaView{&formula})) {
+    return std::move(*res);
   }
-
-  if (matcher::check::Disj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::FolFormula> fol_lhs;
-    std::optional<parser::FolFormula> fol_rhs;
-    matcher::Disj(matcher::RefImpl(fol_lhs), matcher::RefImpl(fol_rhs))
-        .match(std::move(formula));
-
-    return parser::ToFol(!MoveNegInner(std::move(fol_lhs.value())) ||
-                         !MoveNegInner(std::move(fol_rhs.value())));
-  }
-
-  if (matcher::check::Conj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::FolFormula> fol_lhs;
-    std::optional<parser::FolFormula> fol_rhs;
-    matcher::Conj(matcher::RefImpl(fol_lhs), matcher::RefImpl(fol_rhs))
-        .match(std::move(formula));
-
-    return parser::ToFol(!MoveNegInner(std::move(fol_lhs.value())) &&
-                         !MoveNegInner(std::move(fol_rhs.value())));
-  }
-
   return formula;
 }
 
 parser::ImplicationFormula ToConjunctionNormalForm(
     parser::ImplicationFormula formula) {
+  namespace view = matcher::view;
   formula = DeleteUselessBrackets(std::move(formula));
 
   // Pred | ~Pred | [~]Pred or [~]Pred | [~]Pred and [~]Pred ::= <<end>>
@@ -753,117 +246,67 @@ parser::ImplicationFormula ToConjunctionNormalForm(
     return formula;
   }
 
-  // F or (G and H) = ((F) or (G)) and ((F) or (H))
-  if (matcher::check::Disj(
-          matcher::check::Anything(),
-          matcher::check::Conj(matcher::check::Anything(),
-                               matcher::check::Anything()))(formula)) {
-    std::optional<parser::ImplicationFormula> impl_f;
-    std::optional<parser::ImplicationFormula> impl_g;
-    std::optional<parser::ImplicationFormula> impl_h;
-
-    matcher::Disj(matcher::RefImpl(impl_f),
-                  matcher::Brackets(matcher::Conj(matcher::RefImpl(impl_g),
-                                                  matcher::RefImpl(impl_h))))
-        .match(std::move(formula));
-
-    auto impl_f_c = Copy(impl_f.value());
-    auto conj = !ToConjunctionNormalForm({!std::move(impl_f.value()) ||
-                                          !std::move(impl_g.value())}) &&
-                !ToConjunctionNormalForm(
-                    {!std::move(impl_f_c) || !std::move(impl_h.value())});
-
-    return ToConjunctionNormalForm({std::move(conj)});
-  }
-
-  // (G and H) or F = ((F) or (G)) and ((F) or (H))
-  if (matcher::check::Disj(matcher::check::Conj(matcher::check::Anything(),
-                                                matcher::check::Anything()),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ImplicationFormula> impl_f;
-    std::optional<parser::ImplicationFormula> impl_g;
-    std::optional<parser::ImplicationFormula> impl_h;
-
-    matcher::Disj(matcher::Brackets(matcher::Conj(matcher::RefImpl(impl_g),
-                                                  matcher::RefImpl(impl_h))),
-                  matcher::RefImpl(impl_f))
-        .match(std::move(formula));
-
-    auto impl_f_c = Copy(impl_f.value());
-    auto conj = !ToConjunctionNormalForm({!std::move(impl_f.value()) ||
-                                          !std::move(impl_g.value())}) &&
-                !ToConjunctionNormalForm(
-                    {!std::move(impl_f_c) || !std::move(impl_h.value())});
+  std::optional<view::FormulaView> f;
+  std::optional<view::FormulaView> g;
+  std::optional<view::FormulaView> h;
+  std::optional<std::string> var;
 
+  // (F or G) and (F or H), both conjuncts in CNF
+  auto distribute = [&] {
+    auto impl_f = f->Take();
+    auto impl_f_c = CloneFol(impl_f);
+    auto conj =
+        !ToConjunctionNormalForm({!std::move(impl_f) || !g->Take()}) &&
+        !ToConjunctionNormalForm({!std::move(impl_f_c) || !h->Take()});
     return ToConjunctionNormalForm({std::move(conj)});
-  }
-
-  if (matcher::check::Not()(formula)) {
-    std::optional<parser::ImplicationFormula> impl;
-    matcher::Not(matcher::RefImpl(impl)).match(std::move(formula));
-
-    return matcher::UnaryToFol(
-        ~!ToConjunctionNormalForm(std::move(impl.value())));
-  }
-
-  if (matcher::check::Forall()(formula)) {
-    std::optional<parser::ImplicationFormula> impl;
-    std::optional<std::string> var_name;
-    matcher::Forall(matcher::RefName(var_name), matcher::RefImpl(impl))
-        .match(std::move(formula));
-
-    lexer::Variable var_v;
-    var_v.base() = var_name.value();
-
-    return parser::ForAll(std::move(var_v),
-                          ToConjunctionNormalForm(std::move(impl.value())));
-  }
-
-  if (matcher::check::Exists()(formula)) {
-    std::optional<parser::ImplicationFormula> impl;
-    std::optional<std::string> var_name;
-    matcher::Exists(matcher::RefName(var_name), matcher::RefImpl(impl))
-        .match(std::move(formula));
-
-    lexer::Variable var_v;
-    var_v.base() = var_name.value();
-
-    return parser::Exists(std::move(var_v),
-                          ToConjunctionNormalForm(std::move(impl.value())));
-  }
-
-  if (matcher::check::Disj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ImplicationFormula> lhs;
-    std::optional<parser::ImplicationFormula> rhs;
-
-    matcher::Disj(matcher::RefImpl(lhs), matcher::RefImpl(rhs))
-        .match(std::move(formula));
-
-    auto cnf = !ToConjunctionNormalForm(std::move(lhs.value())) ||
-               !ToConjunctionNormalForm(std::move(rhs.value()));
-
-    if (IsAllDisj(cnf)) {
-      return {std::move(cnf)};
-    } else {
-      return ToConjunctionNormalForm({std::move(cnf)});
-    }
-  }
-
-  if (matcher::check::Conj(matcher::check::Anything(),
-                           matcher::check::Anything())(formula)) {
-    std::optional<parser::ImplicationFormula> lhs;
-    std::optional<parser::ImplicationFormula> rhs;
-
-    matcher::Conj(matcher::RefImpl(lhs), matcher::RefImpl(rhs))
-        .match(std::move(formula));
-
-    auto conj = !ToConjunctionNormalForm(std::move(lhs.value())) &&
-                !ToConjunctionNormalForm(std::move(rhs.value()));
+  };
 
-    return {std::move(conj)};
+  auto rules = view::RuleSet{
+      // F or (G and H) = ((F) or (G)) and ((F) or (H))
+      view::On(view::Disj(view::Bind(f),
+                          view::Conj(view::Bind(g), view::Bind(h))),
+               distribute),
+      // (G and H) or F = ((F) or (G)) and ((F) or (H))
+      view::On(view::Disj(view::Conj(view::Bind(g), view::Bind(h)),
+                          view::Bind(f)),
+               distribute),
+      view::On(view::Not(view::Bind(f)),
+               [&] {
+                 return matcher::UnaryToFol(
+                     ~!ToConjunctionNormalForm(f->Take()));
+               }),
+      view::On(view::Forall(view::Bind(var), view::Bind(f)),
+               [&]() -> parser::ImplicationFormula {
+                 lexer::Variable var_v;
+                 var_v.base() = *var;
+                 return parser::ForAll(std::move(var_v),
+                                       ToConjunctionNormalForm(f->Take()));
+               }),
+      view::On(view::Exists(view::Bind(var), view::Bind(f)),
+               [&]() -> parser::ImplicationFormula {
+                 lexer::Variable var_v;
+                 var_v.base() = *var;
+                 return parser::Exists(std::move(var_v),
+                                       ToConjunctionNormalForm(f->Take()));
+               }),
+      view::On(view::Disj(view::Bind(f), view::Bind(g)),
+               [&]() -> parser::ImplicationFormula {
+                 auto cnf = !ToConjunctionNormalForm(f->Take()) ||
+                            !ToConjunctionNormalForm(g->Take());
+                 if (IsAllDisj(cnf)) {
+                   return {std::move(cnf)};
+                 }
+                 return ToConjunctionNormalForm({std::move(cnf)});
+               }),
+      view::On(view::Conj(view::Bind(f), view::Bind(g)),
+               [&]() -> parser::ImplicationFormula {
+                 return {!ToConjunctionNormalForm(f->Take()) &&
+                         !ToConjunctionNormalForm(g->Take())};
+               })};
+
+  if (auto res = rules.Apply(view::FormulaView{&formula})) {
+    return std::move(*res);
   }
-
   return formula;
 }
 
@@ -1052,8 +495,45 @@ parser::FolFormula DeleteUselessBrackets(parser::FolFormula formula) {
   return formula;
 }
 
+// Conjuncts of the matrix are converted as tasks of the current pool, if
+// any, and joined back in their order
 parser::FolFormula ToCNF(parser::FolFormula formula) {
-  return DeleteUselessBrackets(ToConjunctionNormalForm(std::move(formula)));
+  namespace view = matcher::view;
+  auto pool = details::utils::TaskPool::Current();
+  if (!pool) {
+    return DeleteUselessBrackets(ToConjunctionNormalForm(std::move(formula)));
+  }
+
+  std::vector<std::string> prefix;
+  std::optional<view::FormulaView> lhs;
+  std::optional<view::FormulaView> rhs;
+  std::optional<std::string> var;
+  while (view::Forall(view::Bind(var), view::Bind(rhs))
+             .match(view::FormulaView{&formula})) {
+    prefix.push_back(std::move(*var));
+    formula = rhs->Take();
+  }
+
+  std::vector<parser::FolFormula> conjuncts;
+  while (view::Conj(view::Bind(lhs), view::Bind(rhs))
+             .match(view::FormulaView{&formula})) {
+    conjuncts.push_back(lhs->Take());
+    formula = rhs->Take();
+  }
+  conjuncts.push_back(std::move(formula));
+
+  pool->ForEach(conjuncts.size(), [&](std::size_t i) {
+    conjuncts[i] = ToConjunctionNormalForm(std::move(conjuncts[i]));
+  });
+
+  formula = std::move(conjuncts.back());
+  for (auto it = conjuncts.rbegin() + 1; it != conjuncts.rend(); ++it) {
+    formula = parser::ToFol(!std::move(*it) && !std::move(formula));
+  }
+  for (auto it = prefix.rbegin(); it != prefix.rend(); ++it) {
+    formula = parser::ToFol(parser::ForAll(std::move(*it), std::move(formula)));
+  }
+  return DeleteUselessBrackets(std::move(formula));
 }
 
 struct Quantifier {
@@ -1071,31 +551,28 @@ parser::FolFormula Skolemize(
   if (matcher::check::Forall()(formula)) {
     std::optional<parser::ForallFormula> forall_f;
     matcher::RefForall(forall_f).match(std::move(formula));
-    prev.push_back({Quantifier{Quantifier::FORALL, forall_f.value().data.first},
-                    UniqFunName()});
-    return Skolemize(std::move(forall_f.value().data.second), std::move(prev));
+    auto var = forall_f.value().data.first;
+    prev.push_back({Quantifier{Quantifier::FORALL, var}, {}});
+    return parser::ToFol(parser::MakeForall(
+        std::move(var), Skolemize(std::move(forall_f.value().data.second),
+                                  std::move(prev))));
   }
 
   if (matcher::check::Exists()(formula)) {
     std::optional<parser::ExistsFormula> forall_f;
     matcher::RefExists(forall_f).match(std::move(formula));
+    // skolem constant if no universal variable is in scope
+    const bool constant =
+        std::none_of(prev.begin(), prev.end(), [](auto& quantifier) {
+          return quantifier.first.type == Quantifier::FORALL;
+        });
     prev.push_back({Quantifier{Quantifier::EXISTS, forall_f.value().data.first},
-                    UniqFunName()});
+                    constant ? NormalizationContext::Current().FreshConst()
+                             : UniqFunName()});
     return Skolemize(std::move(forall_f.value().data.second), std::move(prev));
   }
 
-  auto wrap_wrap_quant_create = [](auto &&is_forall, auto &&var) {
-    return [=](auto f) -> parser::FolFormula {
-      if (is_forall) {
-        return parser::ToFol(parser::MakeForall(var, std::move(f)));
-      } else {
-        return parser::ToFol(parser::MakeExists(var, std::move(f)));
-      }
-    };
-  };
-
-  auto wrap_quant_prev =
-      [&prev, &wrap_wrap_quant_create](auto f) -> parser::FolFormula {
+  auto wrap_quant_prev = [&prev](auto f) -> parser::FolFormula {
     std::vector<Quantifier> new_quantifiers;
     new_quantifiers.reserve(prev.size());
     for (auto it = prev.begin(); it != prev.end(); ++it) {
@@ -1105,33 +582,22 @@ parser::FolFormula Skolemize(
       }
 
       if (new_quantifiers.empty()) {
-        auto fun = it->second;
-        std::string new_n_fun = fun + "(cEMPTY)";
-        auto generator = lexer::Tokenize(new_n_fun);
-        auto gen_it = generator.begin();
-        auto new_n_fun_t = parser::ParseTerm(gen_it);
-        transform::ReplaceTermVar(f, it->first.var, new_n_fun_t);
+        transform::ReplaceTermVar(
+            f, it->first.var,
+            parser::Term{lexer::Constant{std::string_view{it->second}}});
       } else {
-        std::string new_n_fun =
-            std::accumulate(
-                new_quantifiers.begin() + 1, new_quantifiers.end(),
-                it->second + "(" + new_quantifiers[0].var,
-                [](auto &&lhs, auto &&rhs) { return lhs + ", " + rhs.var; }) +
-            ")";
-        auto generator = lexer::Tokenize(new_n_fun);
-        auto gen_it = generator.begin();
-        auto new_n_fun_t = parser::ParseTerm(gen_it);
-        transform::ReplaceTermVar(f, it->first.var, new_n_fun_t);
+        std::vector<parser::Term> vars;
+        vars.reserve(new_quantifiers.size());
+        for (auto &quantifier : new_quantifiers) {
+          vars.emplace_back(lexer::Variable{std::string_view{quantifier.var}});
+        }
+        transform::ReplaceTermVar(
+            f, it->first.var,
+            parser::Term{lexer::Function{std::string_view{it->second}} *
+                         parser::ToTermList(std::move(vars))});
       }
     }
 
-    for (auto it = new_quantifiers.rbegin(); it != new_quantifiers.rend();
-         ++it) {
-      auto wrap =
-          wrap_wrap_quant_create(it->type == Quantifier::FORALL, it->var);
-      f = wrap(std::move(f));
-    }
-
     return f;
   };
 
@@ -1163,9 +629,13 @@ parser::FolFormula Skolemize(
 parser::FolFormula Normalize(parser::FolFormula formula) {
   formula = RemoveImplication(std::move(formula));
   formula = MoveNegInner(std::move(formula));
+  formula = Miniscope(std::move(formula));
   formula = Skolemize(std::move(formula));
-  formula = NormalizeQuantifiers(std::move(formula));
+  formula = ToPrenex(std::move(formula));
   formula = DeleteUselessBrackets(std::move(formula));
+  if (auto definitional = ToDefinitionalCNF(formula)) {
+    return std::move(*definitional);
+  }
   formula = ToCNF(std::move(formula));
   return formula;
 }
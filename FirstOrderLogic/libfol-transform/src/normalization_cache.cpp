@@ -0,0 +1,111 @@
+#include <libfol-matcher/view_matcher.hpp>
+#include <libfol-parser/parser/print.hpp>
+#include <libfol-transform/normalization.hpp>
+#include <libfol-transform/normalization_cache.hpp>
+#include <libfol-transform/normalized_formula.hpp>
+#include <libfol-transform/replace.hpp>
+#include <optional>
+#include <utility>
+#include <variant>
+
+namespace fol::transform {
+namespace {
+// No variable of a parsed formula has a # in its name
+std::string BoundName(std::size_t number) {
+  return "v#" + std::to_string(number);
+}
+
+void NumberBound(parser::ImplicationFormula& formula, std::size_t& bound);
+
+void NumberBound(parser::UnaryFormula& unary, std::size_t& bound) {
+  if (auto forall = std::get_if<parser::ForallFormula>(&unary.data)) {
+    *forall = RenameVar(std::move(*forall), BoundName(bound++));
+    NumberBound(forall->data.second, bound);
+  } else if (auto exists = std::get_if<parser::ExistsFormula>(&unary.data)) {
+    *exists = RenameVar(std::move(*exists), BoundName(bound++));
+    NumberBound(exists->data.second, bound);
+  } else if (auto not_formula =
+                 std::get_if<parser::NotFormula>(&unary.data)) {
+    NumberBound(*not_formula->data, bound);
+  } else if (auto bracket =
+                 std::get_if<parser::BracketFormula>(&unary.data)) {
+    NumberBound(bracket->data, bound);
+  }
+}
+
+void NumberBound(parser::ConjunctionFormula& conj, std::size_t& bound) {
+  NumberBound(conj.data->first, bound);
+  for (auto* tail = &conj.data->second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<0>(tail->data);
+    NumberBound(next.first, bound);
+    tail = &next.second;
+  }
+}
+
+void NumberBound(parser::DisjunctionFormula& disj, std::size_t& bound) {
+  NumberBound(disj.data.first, bound);
+  for (auto* tail = &disj.data.second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto& next = *std::get<0>(tail->data);
+    NumberBound(next.first, bound);
+    tail = &next.second;
+  }
+}
+
+void NumberBound(parser::ImplicationFormula& formula, std::size_t& bound) {
+  if (auto disj = std::get_if<parser::DisjunctionFormula>(&formula.data)) {
+    NumberBound(*disj, bound);
+  } else {
+    auto& pair = *std::get<1>(formula.data);
+    NumberBound(pair.first, bound);
+    NumberBound(pair.second, bound);
+  }
+}
+
+// Top-level conjuncts, nested brackets flattened
+void SplitConjuncts(parser::FolFormula formula,
+                    std::vector<parser::FolFormula>& conjuncts) {
+  namespace view = matcher::view;
+  std::optional<view::FormulaView> lhs;
+  std::optional<view::FormulaView> rhs;
+  if (view::Conj(view::Bind(lhs), view::Bind(rhs))
+          .match(view::FormulaView{&formula})) {
+    auto first = lhs->Take();
+    auto rest = rhs->Take();
+    SplitConjuncts(std::move(first), conjuncts);
+    SplitConjuncts(std::move(rest), conjuncts);
+    return;
+  }
+  conjuncts.push_back(std::move(formula));
+}
+}  // namespace
+
+std::string AlphaKey(const parser::FolFormula& formula) {
+  auto canonical = CloneFol(formula);
+  std::size_t bound = 0;
+  NumberBound(canonical, bound);
+  return parser::ToString(canonical);
+}
+
+cppcoro::generator<parser::FolFormula> NormalizationCache::Clausify(
+    parser::FolFormula formula) {
+  std::vector<parser::FolFormula> conjuncts;
+  SplitConjuncts(std::move(formula), conjuncts);
+
+  for (auto& conjunct : conjuncts) {
+    auto [it, inserted] = clauses_.try_emplace(AlphaKey(conjunct));
+    if (inserted) {
+      ++stats_.misses;
+      it->second =
+          ToNormalizedFormula(Normalize(std::move(conjunct))).GetDisjunctions();
+    } else {
+      ++stats_.hits;
+    }
+    for (auto& clause : it->second) {
+      auto copy = CloneFol(clause);
+      co_yield copy;
+    }
+  }
+}
+}  // namespace fol::transform
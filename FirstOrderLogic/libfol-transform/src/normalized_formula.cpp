@@ -40,18 +40,49 @@ parser::FolFormula NormalizedFormula::ToFol() const {
   return res;
 }
 
-std::vector<parser::FolFormula> NormalizedFormula::GetDisjunctions() const {
-  std::vector<parser::FolFormula> res;
-
-  auto matrix_s = ToString(formula_matrix_);
-  auto disjunctions_s = details::utils::Split(matrix_s, " and ");
+namespace {
+void CollectConjuncts(parser::FolFormula formula,
+                      std::vector<parser::FolFormula> &res);
+
+void CollectConjunct(parser::UnaryFormula unary,
+                     std::vector<parser::FolFormula> &res) {
+  if (auto bracket = std::get_if<parser::BracketFormula>(&unary.data)) {
+    CollectConjuncts(std::move(bracket->data), res);
+  } else {
+    res.push_back(parser::ToFol(std::move(unary)));
+  }
+}
 
-  res.reserve(disjunctions_s.size());
+// Conjuncts of a matrix in conjunctive normal form, brackets around
+// conjunctions are flattened
+void CollectConjuncts(parser::FolFormula formula,
+                      std::vector<parser::FolFormula> &res) {
+  auto disj = std::get_if<parser::DisjunctionFormula>(&formula.data);
+  if (!disj || !std::holds_alternative<lexer::EPS>(disj->data.second.data)) {
+    res.push_back(std::move(formula));
+    return;
+  }
 
-  for (auto &s : disjunctions_s) {
-    res.push_back(parser::Parse(lexer::Tokenize(s)));
+  auto &conj = *disj->data.first.data;
+  CollectConjunct(std::move(conj.first), res);
+  for (auto *tail = &conj.second;
+       !std::holds_alternative<lexer::EPS>(tail->data);) {
+    auto &next = *std::get<0>(tail->data);
+    CollectConjunct(std::move(next.first), res);
+    tail = &next.second;
   }
+}
+}  // namespace
 
+std::vector<parser::FolFormula> NormalizedFormula::GetDisjunctions() const & {
+  std::vector<parser::FolFormula> res;
+  CollectConjuncts(transform::CloneFol(formula_matrix_), res);
+  return res;
+}
+
+std::vector<parser::FolFormula> NormalizedFormula::GetDisjunctions() && {
+  std::vector<parser::FolFormula> res;
+  CollectConjuncts(std::move(formula_matrix_), res);
   return res;
 }
 
@@ -0,0 +1,171 @@
+#include <libfol-transform/normalization_context.hpp>
+#include <libfol-transform/prenex.hpp>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace fol::transform {
+namespace {
+// Walks a formula keeping the bound variables in scope. The first walk
+// collects the free variables, the second one renames the binders that
+// clash with them or with an earlier binder and pulls the quantifiers out,
+// noting the ones whose variable occurs.
+class PrenexWalker {
+ public:
+  struct Quantifier {
+    bool forall;
+    std::string variable;
+    // false for a vacuous quantifier
+    bool used = false;
+  };
+
+  void CollectFree(parser::ImplicationFormula& formula) {
+    pull_ = false;
+    (*this)(formula);
+  }
+
+  std::vector<Quantifier> Pull(parser::ImplicationFormula& formula) {
+    pull_ = true;
+    (*this)(formula);
+    return std::move(prefix_);
+  }
+
+  void operator()(parser::Term& term) {
+    if (term.IsVar()) {
+      for (auto it = scope_.rbegin(); it != scope_.rend(); ++it) {
+        if (it->name == term.Var()) {
+          if (it->renamed != it->name) {
+            term.SetVar(it->renamed);
+          }
+          if (pull_) {
+            prefix_[it->quantifier].used = true;
+          }
+          return;
+        }
+      }
+      taken_.insert(term.Var());
+    } else if (term.IsFunction()) {
+      term.ModifyFunction([this](parser::FunctionFormula& function) {
+        (*this)(function.data->second);
+      });
+    }
+  }
+
+  void operator()(parser::TermList& term_list) {
+    for (auto it = parser::TermListIt{&term_list}; it != parser::TermListIt{};
+         ++it) {
+      (*this)(*it);
+    }
+  }
+
+  void operator()(parser::UnaryFormula& unary) {
+    if (auto forall = std::get_if<parser::ForallFormula>(&unary.data)) {
+      Quantified(unary, true, forall->data);
+    } else if (auto exists =
+                   std::get_if<parser::ExistsFormula>(&unary.data)) {
+      Quantified(unary, false, exists->data);
+    } else if (auto pred =
+                   std::get_if<parser::PredicateFormula>(&unary.data)) {
+      (*this)(pred->data.second);
+    } else if (auto not_formula =
+                   std::get_if<parser::NotFormula>(&unary.data)) {
+      negative_ = !negative_;
+      (*this)(*not_formula->data);
+      negative_ = !negative_;
+    } else {
+      (*this)(std::get<parser::BracketFormula>(unary.data).data);
+    }
+  }
+
+  void operator()(parser::ConjunctionFormula& conj) {
+    (*this)(conj.data->first);
+    for (auto* tail = &conj.data->second;
+         !std::holds_alternative<lexer::EPS>(tail->data);) {
+      auto& next = *std::get<0>(tail->data);
+      (*this)(next.first);
+      tail = &next.second;
+    }
+  }
+
+  void operator()(parser::DisjunctionFormula& disj) {
+    (*this)(disj.data.first);
+    for (auto* tail = &disj.data.second;
+         !std::holds_alternative<lexer::EPS>(tail->data);) {
+      auto& next = *std::get<0>(tail->data);
+      (*this)(next.first);
+      tail = &next.second;
+    }
+  }
+
+  void operator()(parser::ImplicationFormula& impl) {
+    if (auto disj = std::get_if<parser::DisjunctionFormula>(&impl.data)) {
+      (*this)(*disj);
+      return;
+    }
+    auto& pair = *std::get<1>(impl.data);
+    negative_ = !negative_;
+    (*this)(pair.first);
+    negative_ = !negative_;
+    (*this)(pair.second);
+  }
+
+ private:
+  // bound variable, its new name and its quantifier in the prefix
+  struct Bound {
+    std::string name;
+    std::string renamed;
+    std::size_t quantifier;
+  };
+
+  void Quantified(parser::UnaryFormula& unary, bool forall,
+                  std::pair<std::string, parser::ImplicationFormula>& data) {
+    auto variable = data.first;
+    if (pull_) {
+      if (!taken_.insert(variable).second) {
+        variable = NormalizationContext::Current().FreshVar();
+        taken_.insert(variable);
+      }
+      prefix_.push_back({forall != negative_, variable});
+    }
+
+    scope_.push_back(
+        {data.first, std::move(variable), pull_ ? prefix_.size() - 1 : 0});
+    (*this)(data.second);
+    scope_.pop_back();
+
+    if (pull_) {
+      auto body = std::move(data.second);
+      unary.data = parser::MakeBrackets(std::move(body));
+    }
+  }
+
+  bool pull_ = false;
+  bool negative_ = false;
+  // innermost last
+  std::vector<Bound> scope_;
+  // free variables and the names of the binders seen so far
+  std::unordered_set<std::string> taken_;
+  std::vector<Quantifier> prefix_;
+};
+}  // namespace
+
+parser::FolFormula ToPrenex(parser::FolFormula formula) {
+  PrenexWalker walker;
+  walker.CollectFree(formula);
+  auto prefix = walker.Pull(formula);
+
+  for (auto it = prefix.rbegin(); it != prefix.rend(); ++it) {
+    if (!it->used) {
+      continue;
+    }
+    formula = it->forall
+                  ? parser::ToFol(parser::MakeForall(std::move(it->variable),
+                                                     std::move(formula)))
+                  : parser::ToFol(parser::MakeExists(std::move(it->variable),
+                                                     std::move(formula)));
+  }
+  return formula;
+}
+}  // namespace fol::transform
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libfol-unification/here_unification.hpp>
+#include <libfol-unification/martelli_montanari_unification.hpp>
+#include <libfol-unification/robinson_unification.hpp>
+#include <libfol-unification/unification_interface.hpp>
+#include <memory>
+#include <ostream>
+
+namespace fol::unification {
+// Picks a unification algorithm for every literal pair by the shape of its
+// terms: Robinson for small shallow pairs, Here for pairs with many variables
+// and Martelli-Montanari for the remaining deep or heavy ones.
+class AdaptiveUnificator : public IUnificator {
+ public:
+  enum class Algorithm { ROBINSON, HERE, MARTELLI_MONTANARI };
+
+  struct Thresholds {
+    // pairs not deeper and not heavier than these go to Robinson
+    std::uint32_t robinson_depth = 2;
+    std::uint32_t robinson_weight = 12;
+    // pairs with at least this many distinct variables go to Here
+    std::uint32_t here_vars = 4;
+  };
+
+  struct Stats {
+    std::size_t robinson = 0;
+    std::size_t here = 0;
+    std::size_t martelli_montanari = 0;
+  };
+
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const Thresholds& thresholds);
+
+  friend std::ostream& operator<<(std::ostream& os, const Stats& stats);
+
+  AdaptiveUnificator(Thresholds thresholds, std::shared_ptr<Stats> stats)
+      : thresholds_(thresholds), stats_(std::move(stats)) {}
+
+  static Algorithm Choose(const types::Atom& lhs, const types::Atom& rhs,
+                          const Thresholds& thresholds);
+
+  std::optional<Substitution> Unificate(const types::Atom& lhs,
+                                        const types::Atom& rhs) const override;
+
+ private:
+  Thresholds thresholds_;
+  std::shared_ptr<Stats> stats_;
+  RobinsonUnificator robinson_;
+  HereUnificator here_;
+  MartelliMontanariUnificator martelli_montanari_;
+};
+}  // namespace fol::unification
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <libfol-unification/adaptive_unification.hpp>
+#include <libfol-unification/unification_factory_interface.hpp>
+#include <memory>
+
+namespace fol::unification {
+// Created unificators share the dispatch statistics of the factory
+class AdaptiveUnificatorFactory : public IUnificatorFactory {
+ public:
+  explicit AdaptiveUnificatorFactory(
+      AdaptiveUnificator::Thresholds thresholds = {})
+      : thresholds_(thresholds),
+        stats_(std::make_shared<AdaptiveUnificator::Stats>()) {}
+
+  std::unique_ptr<IUnificator> create() override;
+
+  const AdaptiveUnificator::Thresholds& thresholds() const {
+    return thresholds_;
+  }
+
+  const AdaptiveUnificator::Stats& stats() const { return *stats_; }
+
+ private:
+  AdaptiveUnificator::Thresholds thresholds_;
+  std::shared_ptr<AdaptiveUnificator::Stats> stats_;
+};
+}  // namespace fol::unification
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <libfol-unification/unification_cache.hpp>
+#include <libfol-unification/unification_factory_interface.hpp>
+#include <memory>
+
+namespace fol::unification {
+// Makes every created unificator share one unification cache
+class CachingUnificatorFactory : public IUnificatorFactory {
+ public:
+  CachingUnificatorFactory(std::shared_ptr<IUnificatorFactory> factory,
+                           std::shared_ptr<UnificationCache> cache)
+      : factory_(std::move(factory)), cache_(std::move(cache)) {}
+
+  std::unique_ptr<IUnificator> create() override;
+
+  const UnificationCache& cache() const { return *cache_; }
+
+ private:
+  std::shared_ptr<IUnificatorFactory> factory_;
+  std::shared_ptr<UnificationCache> cache_;
+};
+}  // namespace fol::unification
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <libfol-basictypes/atom.hpp>
+#include <vector>
+
+namespace fol::unification {
+// Symbols at fixed positions of a literal: the signed predicate and the top
+// symbols of its first arguments. Two literals can only unify if at every
+// position the symbols are equal or one of them is a variable.
+struct Fingerprint {
+  static constexpr std::size_t kSize = 8;
+  static constexpr std::uint32_t kVariable = 0;
+  static constexpr std::uint32_t kAbsent = 1;
+
+  alignas(32) std::array<std::uint32_t, kSize> symbols{};
+};
+
+// complementary fingerprints match literals of the opposite sign
+Fingerprint MakeFingerprint(const types::Atom& atom,
+                            bool complementary = false);
+
+bool IsCompatible(const Fingerprint& lhs, const Fingerprint& rhs);
+
+// Literals with their fingerprints laid out contiguously for bulk comparison
+class FingerprintBlock {
+ public:
+  void Add(const types::Atom& atom) {
+    fingerprints_.push_back(MakeFingerprint(atom));
+    atoms_.push_back(&atom);
+  }
+
+  void reserve(std::size_t size) {
+    fingerprints_.reserve(size);
+    atoms_.reserve(size);
+  }
+
+  std::size_t size() const { return atoms_.size(); }
+
+  const types::Atom& operator[](std::size_t i) const { return *atoms_[i]; }
+
+  // appends indices of the literals compatible with query to out, in
+  // increasing order
+  void Filter(const Fingerprint& query, std::vector<std::size_t>& out) const;
+
+ private:
+  std::vector<Fingerprint> fingerprints_;
+  std::vector<const types::Atom*> atoms_;
+};
+}  // namespace fol::unification
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <libfol-basictypes/atom.hpp>
+#include <libfol-basictypes/clause.hpp>
+#include <libfol-basictypes/term.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fol::unification {
+// Bindings of one-sided matching: pattern variable -> subterm of the target.
+// Nothing is copied, so the matched terms must outlive the bindings.
+class MatchBindings {
+ public:
+  std::size_t mark() const { return bindings_.size(); }
+
+  void Undo(std::size_t mark) { bindings_.resize(mark); }
+
+  const types::Term* Find(const std::string& var) const;
+
+  void Bind(const std::string& var, const types::Term& term) {
+    bindings_.emplace_back(&var, &term);
+  }
+
+ private:
+  std::vector<std::pair<const std::string*, const types::Term*>> bindings_;
+};
+
+// pattern * sigma == target, variables of target are treated as constants
+bool Match(const types::Term& pattern, const types::Term& target,
+           MatchBindings& bindings);
+
+bool Match(const types::Atom& pattern, const types::Atom& target,
+           MatchBindings& bindings);
+
+// lhs * sigma is a subset of rhs
+bool Subsumes(const types::Clause& lhs, const types::Clause& rhs);
+}  // namespace fol::unification
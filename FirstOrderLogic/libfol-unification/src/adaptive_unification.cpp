@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <bit>
+#include <libfol-unification/adaptive_unification.hpp>
+
+namespace fol::unification {
+std::ostream& operator<<(std::ostream& os,
+                         const AdaptiveUnificator::Thresholds& thresholds) {
+  return os << "robinson depth: " << thresholds.robinson_depth
+            << ", robinson weight: " << thresholds.robinson_weight
+            << ", here vars: " << thresholds.here_vars;
+}
+
+std::ostream& operator<<(std::ostream& os,
+                         const AdaptiveUnificator::Stats& stats) {
+  return os << "robinson: " << stats.robinson << ", here: " << stats.here
+            << ", martelli-montanari: " << stats.martelli_montanari;
+}
+
+AdaptiveUnificator::Algorithm AdaptiveUnificator::Choose(
+    const types::Atom& lhs, const types::Atom& rhs,
+    const Thresholds& thresholds) {
+  auto depth = std::max(lhs.info().depth, rhs.info().depth);
+  auto weight = lhs.info().weight + rhs.info().weight;
+  // variable signatures may collide, so this is a lower bound
+  auto vars = static_cast<std::uint32_t>(
+      std::popcount(lhs.info().vars | rhs.info().vars));
+
+  if (depth <= thresholds.robinson_depth &&
+      weight <= thresholds.robinson_weight) {
+    return Algorithm::ROBINSON;
+  }
+  if (vars >= thresholds.here_vars) {
+    return Algorithm::HERE;
+  }
+  return Algorithm::MARTELLI_MONTANARI;
+}
+
+std::optional<Substitution> AdaptiveUnificator::Unificate(
+    const types::Atom& lhs, const types::Atom& rhs) const {
+  switch (Choose(lhs, rhs, thresholds_)) {
+    case Algorithm::ROBINSON:
+      ++stats_->robinson;
+      return robinson_.Unificate(lhs, rhs);
+    case Algorithm::HERE:
+      ++stats_->here;
+      return here_.Unificate(lhs, rhs);
+    case Algorithm::MARTELLI_MONTANARI:
+      ++stats_->martelli_montanari;
+      return martelli_montanari_.Unificate(lhs, rhs);
+  }
+  return std::nullopt;
+}
+}  // namespace fol::unification
@@ -0,0 +1,7 @@
+#include <libfol-unification/adaptive_unification_factory.hpp>
+
+namespace fol::unification {
+std::unique_ptr<IUnificator> AdaptiveUnificatorFactory::create() {
+  return std::make_unique<AdaptiveUnificator>(thresholds_, stats_);
+}
+}  // namespace fol::unification
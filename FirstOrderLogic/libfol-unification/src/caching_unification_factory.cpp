@@ -0,0 +1,9 @@
+#include <libfol-unification/caching_unification_factory.hpp>
+
+namespace fol::unification {
+std::unique_ptr<IUnificator> CachingUnificatorFactory::create() {
+  auto unificator = factory_->create();
+  unificator->SetCache(cache_);
+  return unificator;
+}
+}  // namespace fol::unification
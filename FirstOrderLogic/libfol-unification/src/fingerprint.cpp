@@ -0,0 +1,115 @@
+#include <libfol-unification/fingerprint.hpp>
+#include <string_view>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace fol::unification {
+namespace {
+std::uint32_t Symbol(std::string_view name, std::size_t arity) {
+  // FNV-1a
+  std::uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+  }
+  hash = (hash ^ static_cast<std::uint32_t>(arity)) * 16777619u;
+  return hash > Fingerprint::kAbsent ? hash : hash + 2;
+}
+
+std::uint32_t Symbol(const types::Term& term) {
+  if (term.IsVar()) {
+    return Fingerprint::kVariable;
+  }
+  if (term.IsConstant()) {
+    return Symbol(term.Const(), 0);
+  }
+
+  std::size_t arity = 0;
+  for (auto it = parser::FunctionTermsIt(term.Function());
+       it != parser::ConstTermListIt{}; ++it) {
+    ++arity;
+  }
+  return Symbol(parser::FunctionName(term.Function()), arity);
+}
+}  // namespace
+
+Fingerprint MakeFingerprint(const types::Atom& atom, bool complementary) {
+  Fingerprint fingerprint;
+  fingerprint.symbols.fill(Fingerprint::kAbsent);
+
+  auto predicate = Symbol(atom.predicate_name(), atom.terms_size());
+  fingerprint.symbols[0] =
+      (atom.negative() != complementary) ? predicate : ~predicate;
+  if (fingerprint.symbols[0] <= Fingerprint::kAbsent) {
+    fingerprint.symbols[0] += 2;
+  }
+
+  for (std::size_t i = 0;
+       i < atom.terms_size() && i + 1 < Fingerprint::kSize; ++i) {
+    fingerprint.symbols[i + 1] = Symbol(atom[i]);
+  }
+
+  return fingerprint;
+}
+
+bool IsCompatible(const Fingerprint& lhs, const Fingerprint& rhs) {
+  for (std::size_t i = 0; i < Fingerprint::kSize; ++i) {
+    if (lhs.symbols[i] != rhs.symbols[i] &&
+        lhs.symbols[i] != Fingerprint::kVariable &&
+        rhs.symbols[i] != Fingerprint::kVariable) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FingerprintBlock::Filter(const Fingerprint& query,
+                              std::vector<std::size_t>& out) const {
+#if defined(__AVX2__)
+  const auto zero = _mm256_setzero_si256();
+  const auto q = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(query.symbols.data()));
+  const auto q_var = _mm256_cmpeq_epi32(q, zero);
+  for (std::size_t i = 0; i < fingerprints_.size(); ++i) {
+    const auto c = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(fingerprints_[i].symbols.data()));
+    const auto ok = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi32(q, c), q_var),
+        _mm256_cmpeq_epi32(c, zero));
+    if (_mm256_movemask_epi8(ok) == -1) {
+      out.push_back(i);
+    }
+  }
+#elif defined(__SSE2__)
+  const auto zero = _mm_setzero_si128();
+  const auto q_lo =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(query.symbols.data()));
+  const auto q_hi = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(query.symbols.data() + 4));
+  const auto q_lo_var = _mm_cmpeq_epi32(q_lo, zero);
+  const auto q_hi_var = _mm_cmpeq_epi32(q_hi, zero);
+  for (std::size_t i = 0; i < fingerprints_.size(); ++i) {
+    const auto* symbols = fingerprints_[i].symbols.data();
+    const auto c_lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(symbols));
+    const auto c_hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(symbols + 4));
+    const auto ok = _mm_and_si128(
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(q_lo, c_lo), q_lo_var),
+                     _mm_cmpeq_epi32(c_lo, zero)),
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(q_hi, c_hi), q_hi_var),
+                     _mm_cmpeq_epi32(c_hi, zero)));
+    if (_mm_movemask_epi8(ok) == 0xFFFF) {
+      out.push_back(i);
+    }
+  }
+#else
+  for (std::size_t i = 0; i < fingerprints_.size(); ++i) {
+    if (IsCompatible(query, fingerprints_[i])) {
+      out.push_back(i);
+    }
+  }
+#endif
+}
+}  // namespace fol::unification
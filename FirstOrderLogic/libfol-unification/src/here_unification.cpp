@@ -83,27 +83,36 @@ void RecurHere(types::Term& v, types::Term& y, types::Term& t, MapType& map,
 }
 
 void Here(types::Term& lhs, types::Term& rhs, MapType& map, VarSet& vars) {
-  if (lhs != rhs && !lhs.IsConstant() && !rhs.IsConstant()) {
+  if (lhs != rhs) {
     if (lhs.IsVar()) {
       VarHere(lhs, rhs, map, vars);
     } else if (rhs.IsVar()) {
       VarHere(rhs, lhs, map, vars);
+    } else if (lhs.IsConstant() || rhs.IsConstant()) {
+      throw HereUnificator::ExitClash{"CLASH"};
     } else {
-      auto& f_lhs = lhs.Function();
-      auto& f_rhs = rhs.Function();
-
-      if (FunctionName(f_lhs) != FunctionName(f_rhs)) {
+      if (FunctionName(lhs.Function()) != FunctionName(rhs.Function())) {
         throw HereUnificator::ExitClash{"CLASH"};
-      } else {
-        auto lhs_t_list = FunctionTermsIt(lhs.Function());
-        auto rhs_t_list = FunctionTermsIt(rhs.Function());
-
-        for (; lhs_t_list != parser::TermListIt{} &&
-               rhs_t_list != parser::TermListIt{};
-             ++lhs_t_list, ++rhs_t_list) {
-          Here(*lhs_t_list, *rhs_t_list, map, vars);
-        }
       }
+
+      // the map keeps pointers to the arguments, which TermVere may replace
+      lhs.ModifyFunction([&](parser::FunctionFormula& f_lhs) {
+        rhs.ModifyFunction([&](parser::FunctionFormula& f_rhs) {
+          auto lhs_t_list = FunctionTermsIt(f_lhs);
+          auto rhs_t_list = FunctionTermsIt(f_rhs);
+
+          for (; lhs_t_list != parser::TermListIt{} &&
+                 rhs_t_list != parser::TermListIt{};
+               ++lhs_t_list, ++rhs_t_list) {
+            Here(*lhs_t_list, *rhs_t_list, map, vars);
+          }
+
+          if (lhs_t_list != parser::TermListIt{} ||
+              rhs_t_list != parser::TermListIt{}) {
+            throw HereUnificator::ExitClash{"CLASH"};
+          }
+        });
+      });
     }
   }
 }
@@ -134,23 +143,25 @@ void Collapse(auto it_beg, auto it_end, types::Term& var, MapType& map) {
 }
 
 types::Term& TermVere(parser::Term& t, MapType& map, SubstitutionMap& s) {
-  auto t_list = FunctionTermsIt(t.Function());
-  for (; t_list != parser::TermListIt{}; ++t_list) {
-    if (t_list->IsVar()) {
-      if (map[t_list->Var()].index() == HereUnificator::DONE) {
-        if (s[t_list->Var()].index() == HereUnificator::LOOP) {
-          throw HereUnificator::ExitLoop{"LOOP"};
-        } else if (s[t_list->Var()].index() == HereUnificator::TERM) {
-          *t_list =
-              types::Clone(*std::get<HereUnificator::TERM>(s[t_list->Var()]));
+  t.ModifyFunction([&](parser::FunctionFormula& function) {
+    auto t_list = FunctionTermsIt(function);
+    for (; t_list != parser::TermListIt{}; ++t_list) {
+      if (t_list->IsVar()) {
+        if (map[t_list->Var()].index() == HereUnificator::DONE) {
+          if (s[t_list->Var()].index() == HereUnificator::LOOP) {
+            throw HereUnificator::ExitLoop{"LOOP"};
+          } else if (s[t_list->Var()].index() == HereUnificator::TERM) {
+            *t_list = types::Clone(
+                *std::get<HereUnificator::TERM>(s[t_list->Var()]));
+          }
+        } else if (map[t_list->Var()].index() != HereUnificator::NIL) {
+          *t_list = types::Clone(Vere(*t_list, map, s));
         }
-      } else if (map[t_list->Var()].index() != HereUnificator::NIL) {
-        *t_list = types::Clone(Vere(*t_list, map, s));
+      } else if (t_list->IsFunction()) {
+        *t_list = types::Clone(TermVere(*t_list, map, s));
       }
-    } else if (t_list->IsFunction()) {
-      *t_list = types::Clone(TermVere(*t_list, map, s));
     }
-  }
+  });
 
   return t;
 }
@@ -228,12 +239,18 @@ std::optional<Substitution> HereUnificator::Unificate(
     return std::nullopt;
   }
 
-  auto cp_lhs = lhs;
-  auto cp_rhs = rhs;
-
   MapType map;
   VarSet vars;
 
+  std::vector<types::Term> cp_lhs;
+  std::vector<types::Term> cp_rhs;
+  cp_lhs.reserve(lhs.terms_size());
+  cp_rhs.reserve(rhs.terms_size());
+  for (std::size_t i = 0; i < lhs.terms_size(); ++i) {
+    cp_lhs.push_back(types::Clone(lhs[i]));
+    cp_rhs.push_back(types::Clone(rhs[i]));
+  }
+
   for (std::size_t i = 0; i < lhs.terms_size(); ++i) {
     Here(cp_lhs[i], cp_rhs[i], map, vars);
   }
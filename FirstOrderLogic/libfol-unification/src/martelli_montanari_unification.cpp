@@ -14,9 +14,9 @@ MartelliMontanariUnificator::Result ApplyRules(
         return MartelliMontanariUnificator::Result::ERROR;
       }
 
-      auto lhs_termlist = parser::FunctionTerms(std::move(eq.first.Function()));
+      auto lhs_termlist = parser::FunctionTerms(std::move(eq.first).Function());
       auto rhs_termlist =
-          parser::FunctionTerms(std::move(eq.second.Function()));
+          parser::FunctionTerms(std::move(eq.second).Function());
 
       if (lhs_termlist.size() != rhs_termlist.size()) {
         return MartelliMontanariUnificator::Result::ERROR;
@@ -48,6 +48,11 @@ MartelliMontanariUnificator::Result ApplyRules(
     }
     // RULE 3 END
 
+    // distinct constants or a constant against a function
+    if (!eq.first.IsVar()) {
+      return MartelliMontanariUnificator::Result::ERROR;
+    }
+
     // RULE 4
     if (eq.first.IsVar() && !types::Contains(eq.second, eq.first)) {
       auto substitution =
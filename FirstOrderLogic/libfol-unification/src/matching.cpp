@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <libfol-unification/matching.hpp>
+
+namespace fol::unification {
+namespace {
+bool Equal(const types::Term& lhs, const types::Term& rhs);
+
+bool Equal(const parser::FunctionFormula& lhs,
+           const parser::FunctionFormula& rhs) {
+  if (parser::FunctionName(lhs) != parser::FunctionName(rhs)) {
+    return false;
+  }
+
+  auto lhs_it = parser::FunctionTermsIt(lhs);
+  auto rhs_it = parser::FunctionTermsIt(rhs);
+  for (; lhs_it != parser::ConstTermListIt{} &&
+         rhs_it != parser::ConstTermListIt{};
+       ++lhs_it, ++rhs_it) {
+    if (!Equal(*lhs_it, *rhs_it)) {
+      return false;
+    }
+  }
+
+  return lhs_it == parser::ConstTermListIt{} &&
+         rhs_it == parser::ConstTermListIt{};
+}
+
+bool Equal(const types::Term& lhs, const types::Term& rhs) {
+  if (lhs.data().index() != rhs.data().index()) {
+    return false;
+  }
+  if (lhs.IsConstant()) {
+    return lhs.Const() == rhs.Const();
+  }
+  if (lhs.IsVar()) {
+    return lhs.Var() == rhs.Var();
+  }
+  return Equal(lhs.Function(), rhs.Function());
+}
+
+bool IsCandidate(const types::Atom& pattern, const types::Atom& target) {
+  // instances are never lighter or shallower than the pattern
+  return pattern.negative() == target.negative() &&
+         pattern.terms_size() == target.terms_size() &&
+         pattern.info().weight <= target.info().weight &&
+         pattern.info().depth <= target.info().depth &&
+         pattern.predicate_name() == target.predicate_name();
+}
+
+bool SubsumesFrom(
+    const std::vector<std::vector<const types::Atom*>>& candidates,
+    const std::vector<const types::Atom*>& patterns, std::size_t i,
+    MatchBindings& bindings) {
+  if (i == patterns.size()) {
+    return true;
+  }
+
+  auto mark = bindings.mark();
+  for (auto* target : candidates[i]) {
+    if (Match(*patterns[i], *target, bindings) &&
+        SubsumesFrom(candidates, patterns, i + 1, bindings)) {
+      return true;
+    }
+    bindings.Undo(mark);
+  }
+
+  return false;
+}
+}  // namespace
+
+const types::Term* MatchBindings::Find(const std::string& var) const {
+  for (auto it = bindings_.rbegin(); it != bindings_.rend(); ++it) {
+    if (it->first == &var || *it->first == var) {
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
+bool Match(const types::Term& pattern, const types::Term& target,
+           MatchBindings& bindings) {
+  if (pattern.info().ground) {
+    return Equal(pattern, target);
+  }
+
+  if (pattern.IsVar()) {
+    if (auto* bound = bindings.Find(pattern.Var())) {
+      return Equal(*bound, target);
+    }
+    bindings.Bind(pattern.Var(), target);
+    return true;
+  }
+
+  if (pattern.IsConstant()) {
+    return target.IsConstant() && pattern.Const() == target.Const();
+  }
+
+  if (!target.IsFunction() || parser::FunctionName(pattern.Function()) !=
+                                  parser::FunctionName(target.Function())) {
+    return false;
+  }
+
+  auto pattern_it = parser::FunctionTermsIt(pattern.Function());
+  auto target_it = parser::FunctionTermsIt(target.Function());
+  for (; pattern_it != parser::ConstTermListIt{} &&
+         target_it != parser::ConstTermListIt{};
+       ++pattern_it, ++target_it) {
+    if (!Match(*pattern_it, *target_it, bindings)) {
+      return false;
+    }
+  }
+
+  return pattern_it == parser::ConstTermListIt{} &&
+         target_it == parser::ConstTermListIt{};
+}
+
+bool Match(const types::Atom& pattern, const types::Atom& target,
+           MatchBindings& bindings) {
+  if (!IsCandidate(pattern, target)) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < pattern.terms_size(); ++i) {
+    if (!Match(pattern[i], target[i], bindings)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Subsumes(const types::Clause& lhs, const types::Clause& rhs) {
+  if (lhs.atoms().size() == 1) {
+    MatchBindings bindings;
+    return std::any_of(rhs.atoms().begin(), rhs.atoms().end(),
+                       [&](auto&& target) {
+                         bindings.Undo(0);
+                         return Match(lhs.atoms().front(), target, bindings);
+                       });
+  }
+
+  std::vector<const types::Atom*> patterns;
+  patterns.reserve(lhs.atoms().size());
+  for (auto& atom : lhs.atoms()) {
+    patterns.push_back(&atom);
+  }
+
+  std::vector<std::vector<const types::Atom*>> candidates(patterns.size());
+  for (std::size_t i = 0; i < patterns.size(); ++i) {
+    for (auto& target : rhs.atoms()) {
+      if (IsCandidate(*patterns[i], target)) {
+        candidates[i].push_back(&target);
+      }
+    }
+    if (candidates[i].empty()) {
+      return false;
+    }
+  }
+
+  // most constrained literals first
+  std::vector<std::size_t> order(patterns.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](auto&& lhs_i, auto&& rhs_i) {
+    return candidates[lhs_i].size() < candidates[rhs_i].size();
+  });
+
+  std::vector<const types::Atom*> sorted_patterns;
+  std::vector<std::vector<const types::Atom*>> sorted_candidates;
+  sorted_patterns.reserve(order.size());
+  sorted_candidates.reserve(order.size());
+  for (auto i : order) {
+    sorted_patterns.push_back(patterns[i]);
+    sorted_candidates.push_back(std::move(candidates[i]));
+  }
+
+  MatchBindings bindings;
+  return SubsumesFrom(sorted_candidates, sorted_patterns, 0, bindings);
+}
+}  // namespace fol::unification
@@ -1,62 +1,58 @@
 #include <libfol-unification/robinson_unification.hpp>
+#include <utility>
 
 namespace fol::unification {
 namespace {
-std::optional<Substitution> UnificateFunction(const types::Function& lhs,
-                                              const types::Function& rhs) {
-  if (lhs.function_name() != rhs.function_name()) {
-    return std::nullopt;
+bool UnificateTerms(types::Term t1_cp, types::Term t2_cp, Substitution& res);
+
+bool UnificateFunction(const parser::FunctionFormula& lhs,
+                       const parser::FunctionFormula& rhs, Substitution& res) {
+  if (parser::FunctionName(lhs) != parser::FunctionName(rhs)) {
+    return false;
   }
-  Substitution res;
 
-  for (const types::Term& t1 : lhs.terms()) {
-    for (const types::Term& t2 : rhs.terms()) {
-      auto t1_cp = types::Clone(t1);
-      auto t2_cp = types::Clone(t2);
-      res.Substitute(t1_cp);
-      res.Substitute(t2_cp);
-
-      if (t1_cp == t2_cp) {
-        continue;
-      }
-
-      if (t1_cp.IsVar() && !t2_cp.IsVar()) {
-        // t2_cp contains t1_cp
-        if (types::Contains(t2_cp, t1_cp)) {
-          return std::nullopt;
-        }
-
-        res += Substitution({{t1_cp.Var(), t2_cp}});
-      }
-
-      if (t2_cp.IsVar() && !t1_cp.IsVar()) {
-        // t1_cp contains t2_cp
-        if (types::Contains(t1_cp, t2_cp)) {
-          return std::nullopt;
-        }
-
-        res += Substitution({{t2_cp.Var(), t1_cp}});
-      }
-
-      if (t1_cp.IsFunction() && t2_cp.IsFunction()) {
-        auto sub = UnificateFunction(std::move(t1_cp.Function()),
-                                     std::move(t2_cp.Function()));
-
-        if (sub.has_value()) {
-          res += *sub;
-        } else {
-          return std::nullopt;
-        }
-      }
-
-      if (t1_cp.IsConstant() && t2_cp.IsConstant() &&
-          t1_cp.Const() != t2_cp.Const()) {
-        return std::nullopt;
-      }
+  auto lhs_it = parser::FunctionTermsIt(lhs);
+  auto rhs_it = parser::FunctionTermsIt(rhs);
+  for (; lhs_it != parser::ConstTermListIt{} &&
+         rhs_it != parser::ConstTermListIt{};
+       ++lhs_it, ++rhs_it) {
+    if (!UnificateTerms(types::Clone(*lhs_it), types::Clone(*rhs_it), res)) {
+      return false;
     }
   }
 
-  return res;
+  return lhs_it == parser::ConstTermListIt{} &&
+         rhs_it == parser::ConstTermListIt{};
+}
+
+bool UnificateTerms(types::Term t1_cp, types::Term t2_cp, Substitution& res) {
+  res.Substitute(t1_cp);
+  res.Substitute(t2_cp);
+
+  if (t1_cp == t2_cp) {
+    return true;
+  }
+
+  if (!t1_cp.IsVar() && t2_cp.IsVar()) {
+    std::swap(t1_cp, t2_cp);
+  }
+
+  if (t1_cp.IsVar()) {
+    // t2_cp contains t1_cp
+    if (types::Contains(t2_cp, t1_cp)) {
+      return false;
+    }
+
+    res += Substitution({{t1_cp.Var(), t2_cp}});
+    return true;
+  }
+
+  if (t1_cp.IsFunction() && t2_cp.IsFunction()) {
+    return UnificateFunction(t1_cp.Function(), t2_cp.Function(), res);
+  }
+
+  // distinct constants or a constant against a function
+  return false;
 }
 }  // namespace
 
@@ -68,57 +64,10 @@ std::optional<Substitution> RobinsonUnificator::Unificate(
   }
 
   Substitution res;
-  auto lhs_cl = lhs;
-  auto rhs_cl = rhs;
 
   for (std::size_t i = 0; i < lhs.terms().size(); ++i) {
-    auto t1_cp = types::Clone(lhs.terms()[i]);
-    auto t2_cp = types::Clone(rhs.terms()[i]);
-
-    // auto& t1_cp = lhs_cl[i];
-    // auto& t2_cp = rhs_cl[i];
-    res.Substitute(t1_cp);
-    res.Substitute(t2_cp);
-
-    if (t1_cp == t2_cp) {
-      continue;
-    }
-
-    if (t1_cp.IsVar() && t2_cp.IsVar()) {
-      res += Substitution({{t1_cp.Var(), t2_cp}});
-    }
-
-    if (t1_cp.IsVar() && !t2_cp.IsVar()) {
-      // t2_cp contains t1_cp
-      if (types::Contains(t2_cp, t1_cp)) {
-        return std::nullopt;
-      }
-
-      res += Substitution({{t1_cp.Var(), t2_cp}});
-    }
-
-    if (t2_cp.IsVar() && !t1_cp.IsVar()) {
-      // t1_cp contains t2_cp
-      if (types::Contains(t1_cp, t2_cp)) {
-        return std::nullopt;
-      }
-
-      res += Substitution({{t2_cp.Var(), t1_cp}});
-    }
-
-    if (t1_cp.IsFunction() && t2_cp.IsFunction()) {
-      auto sub = UnificateFunction(std::move(t1_cp.Function()),
-                                   std::move(t2_cp.Function()));
-
-      if (sub.has_value()) {
-        res += *sub;
-      } else {
-        return std::nullopt;
-      }
-    }
-
-    if (t1_cp.IsConstant() && t2_cp.IsConstant() &&
-        t1_cp.Const() != t2_cp.Const()) {
+    if (!UnificateTerms(types::Clone(lhs.terms()[i]),
+                        types::Clone(rhs.terms()[i]), res)) {
       return std::nullopt;
     }
   }
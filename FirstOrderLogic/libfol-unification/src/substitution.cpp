@@ -0,0 +1,98 @@
+#include <libfol-unification/substitution.hpp>
+
+namespace fol::unification {
+Substitution::Substitution(std::vector<SubstitutePair> substitution) {
+  bindings_.reserve(substitution.size());
+  for (auto& pair : substitution) {
+    Bind(std::move(pair));
+  }
+}
+
+Substitution& Substitution::operator+=(const Substitution& o) {
+  bindings_.reserve(bindings_.size() + o.bindings_.size());
+  for (auto& pair : o.bindings_) {
+    if (!index_.contains(pair.from)) {
+      Bind(pair);
+    }
+  }
+
+  return *this;
+}
+
+void Substitution::Bind(SubstitutePair pair) {
+  if (index_.contains(pair.from)) {
+    return;
+  }
+
+  // drop bindings that dereference to the variable itself
+  for (const types::Term* to = &pair.to; to && to->IsVar();
+       to = Find(to->Var())) {
+    if (to->Var() == pair.from) {
+      return;
+    }
+  }
+
+  index_.emplace(pair.from, bindings_.size());
+  bindings_.push_back(std::move(pair));
+}
+
+types::Term Substitution::Apply(const types::Term& term) const {
+  if (term.IsVar()) {
+    if (auto* to = Find(term.Var())) {
+      return Apply(*to);
+    }
+    return types::Term{term.Var()};
+  }
+
+  if (term.IsConstant()) {
+    return types::Term{term.Const()};
+  }
+
+  std::vector<types::Term> args;
+  for (auto it = parser::FunctionTermsIt(term.Function());
+       it != parser::ConstTermListIt{}; ++it) {
+    args.push_back(Apply(*it));
+  }
+
+  auto name = term.Function().data->first;
+  return types::Term{std::move(name) * parser::ToTermList(std::move(args))};
+}
+
+types::Atom Substitution::Apply(const types::Atom& atom) const {
+  std::vector<types::Term> terms;
+  terms.reserve(atom.terms_size());
+  for (auto& term : atom.terms()) {
+    terms.push_back(Apply(term));
+  }
+
+  return types::Atom(atom.negative(), atom.predicate_name(), std::move(terms));
+}
+
+void Substitution::Substitute(types::Term& term) const {
+  if (term.IsVar()) {
+    if (auto* to = Find(term.Var())) {
+      term = Apply(*to);
+    }
+  } else if (term.IsFunction()) {
+    term.ModifyFunction([this](parser::FunctionFormula& function) {
+      for (auto it = parser::FunctionTermsIt(function);
+           it != parser::TermListIt{}; ++it) {
+        Substitute(*it);
+      }
+    });
+  }
+}
+
+void Substitution::Substitute(types::Atom& atom) const {
+  if (bindings_.empty()) {
+    return;
+  }
+  atom.ModifyTerms([this](types::Term& term) { Substitute(term); });
+}
+
+void Substitution::Substitute(types::Clause& clause) const {
+  for (auto& atom : clause.atoms()) {
+    Substitute(atom);
+  }
+}
+}  // namespace fol::unification
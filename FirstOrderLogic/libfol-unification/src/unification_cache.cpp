@@ -0,0 +1,162 @@
+#include <libfol-unification/unification_cache.hpp>
+#include <libfol-unification/unification_interface.hpp>
+
+namespace fol::unification {
+namespace {
+class VarNumbering {
+ public:
+  std::size_t Number(const std::string& var) {
+    for (std::size_t i = 0; i < names_.size(); ++i) {
+      if (names_[i] == var) {
+        return i;
+      }
+    }
+    names_.push_back(var);
+    return names_.size() - 1;
+  }
+
+  std::optional<std::size_t> Find(const std::string& var) const {
+    for (std::size_t i = 0; i < names_.size(); ++i) {
+      if (names_[i] == var) {
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  const std::string& Name(std::size_t i) const { return names_[i]; }
+
+ private:
+  std::vector<std::string> names_;
+};
+
+void AppendKey(const types::Term& term, VarNumbering& vars, std::string& key) {
+  if (term.IsVar()) {
+    key += '#';
+    key += std::to_string(vars.Number(term.Var()));
+  } else if (term.IsConstant()) {
+    key += term.Const();
+  } else {
+    key += parser::FunctionName(term.Function());
+    key += '(';
+    for (auto it = parser::FunctionTermsIt(term.Function());
+         it != parser::ConstTermListIt{}; ++it) {
+      AppendKey(*it, vars, key);
+      key += ',';
+    }
+    key += ')';
+  }
+}
+
+void AppendKey(const types::Atom& atom, VarNumbering& vars, std::string& key) {
+  key += atom.predicate_name();
+  key += '(';
+  for (auto& term : atom.terms()) {
+    AppendKey(term, vars, key);
+    key += ',';
+  }
+  key += ')';
+}
+
+template <class F>
+std::optional<types::Term> MapVars(const types::Term& term, F&& map_var) {
+  if (term.IsVar()) {
+    auto var = map_var(term.Var());
+    if (!var) {
+      return std::nullopt;
+    }
+    return types::Term{lexer::Variable{std::string_view{*var}}};
+  }
+  if (term.IsConstant()) {
+    return types::Term{term.Const()};
+  }
+
+  std::vector<types::Term> args;
+  for (auto it = parser::FunctionTermsIt(term.Function());
+       it != parser::ConstTermListIt{}; ++it) {
+    auto arg = MapVars(*it, map_var);
+    if (!arg) {
+      return std::nullopt;
+    }
+    args.push_back(std::move(*arg));
+  }
+
+  const auto& name = parser::FunctionName(term.Function());
+  return types::Term{lexer::Function{std::string_view{name}} *
+                     parser::ToTermList(std::move(args))};
+}
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os,
+                         const UnificationCache::Stats& stats) {
+  return os << "hits: " << stats.hits << ", misses: " << stats.misses
+            << ", evictions: " << stats.evictions
+            << ", hit rate: " << 100 * stats.HitRate() << "%";
+}
+
+std::optional<Substitution> UnificationCache::Unificate(
+    const types::Atom& lhs, const types::Atom& rhs,
+    const IUnificator& unificator) {
+  VarNumbering vars;
+  std::string key;
+  AppendKey(lhs, vars, key);
+  key += '=';
+  AppendKey(rhs, vars, key);
+
+  if (auto it = index_.find(key); it != index_.end()) {
+    ++stats_.hits;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    auto& entry = *it->second;
+    if (!entry.unifiable) {
+      return std::nullopt;
+    }
+
+    std::vector<Substitution::SubstitutePair> pairs;
+    pairs.reserve(entry.mgu.size());
+    for (auto& [from, to] : entry.mgu) {
+      auto term = MapVars(to, [&](const std::string& var) {
+        return std::optional{vars.Name(std::stoul(var))};
+      });
+      pairs.emplace_back(vars.Name(from), *term);
+    }
+    return Substitution{pairs};
+  }
+
+  ++stats_.misses;
+  auto result = unificator.Unificate(lhs, rhs);
+
+  Entry entry{std::move(key), result.has_value(), {}};
+  if (result) {
+    for (auto& pair : result->bindings()) {
+      auto from = vars.Find(pair.from);
+      auto to = MapVars(pair.to, [&](const std::string& var) {
+        auto i = vars.Find(var);
+        return i ? std::optional{std::to_string(*i)} : std::nullopt;
+      });
+      // the unifier introduced a variable of its own, keep it uncached
+      if (!from || !to) {
+        return result;
+      }
+      entry.mgu.emplace_back(*from, std::move(*to));
+    }
+  }
+
+  Insert(std::move(entry));
+
+  return result;
+}
+
+void UnificationCache::Insert(Entry entry) {
+  if (capacity_ == 0) {
+    return;
+  }
+  if (entries_.size() >= capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().key, entries_.begin());
+}
+}  // namespace fol::unification
@@ -1,13 +1,23 @@
+#include <libfol-unification/matching.hpp>
 #include <libfol-unification/unification_interface.hpp>
+#include <tuple>
 
 namespace fol::unification {
+std::optional<Substitution> IUnificator::CachedUnificate(
+    const types::Atom& lhs, const types::Atom& rhs) const {
+  if (!cache_) {
+    return Unificate(lhs, rhs);
+  }
+  return cache_->Unificate(lhs, rhs, *this);
+}
+
 void IUnificator::Simplify(types::Clause& clause) const {
   auto& atoms_ = clause.atoms();
   for (std::vector<types::Atom>::size_type i = 0; i < clause.atoms().size();
        ++i) {
     for (std::vector<types::Atom>::size_type j = i + 1;
          j < clause.atoms().size(); ++j) {
-      if (auto substitution = this->Unificate(atoms_[i], atoms_[j])) {
+      if (auto substitution = CachedUnificate(atoms_[i], atoms_[j])) {
         substitution.value().Substitute(clause);
       }
     }
@@ -37,23 +47,52 @@ void IUnificator::Simplify(types::Clause& clause) const {
 
 bool IUnificator::IsPartOf(const types::Clause& lhs,
                            const types::Clause& rhs) const {
-  for (auto& lhs_atom : lhs.atoms()) {
-    bool contains = false;
-    for (auto& rhs_atom : rhs.atoms()) {
-      if (rhs_atom.negative() != lhs_atom.negative()) {
-        continue;
-      }
-      if (auto sub = Unificate(lhs_atom, rhs_atom)) {
-        contains = true;
-        break;
-      }
+  return Subsumes(lhs, rhs);
+}
+
+std::vector<std::pair<std::size_t, Substitution>> IUnificator::UnificateBatch(
+    const types::Atom& query, const FingerprintBlock& block,
+    bool complementary) const {
+  std::vector<std::size_t> candidates;
+  block.Filter(MakeFingerprint(query, complementary), candidates);
+
+  std::vector<std::pair<std::size_t, Substitution>> res;
+  for (auto i : candidates) {
+    if ((block[i].negative() != query.negative()) != complementary) {
+      continue;
     }
-    if (!contains) {
-      return false;
+    if (auto sub = CachedUnificate(query, block[i])) {
+      res.emplace_back(i, std::move(*sub));
     }
   }
 
-  return true;
+  return res;
+}
+
+types::Clause IUnificator::Resolve(const types::Clause& lhs, std::size_t lhs_i,
+                                   const types::Clause& rhs, std::size_t rhs_i,
+                                   const Substitution& sub) const {
+  std::vector<types::Atom> atoms;
+  atoms.reserve(lhs.atoms().size() + rhs.atoms().size() - 2);
+  for (std::size_t i = 0; i < lhs.atoms().size(); ++i) {
+    if (i != lhs_i) {
+      atoms.push_back(sub.Apply(lhs.atoms()[i]));
+    }
+  }
+  for (std::size_t i = 0; i < rhs.atoms().size(); ++i) {
+    if (i != rhs_i) {
+      atoms.push_back(sub.Apply(rhs.atoms()[i]));
+    }
+  }
+
+  types::Clause resolvent(std::move(atoms));
+
+  Simplify(resolvent);
+
+  resolvent.AddAncestor(lhs);
+  resolvent.AddAncestor(rhs);
+
+  return resolvent;
 }
 
 std::optional<types::Clause> IUnificator::Resolution(types::Clause lhs,
@@ -61,43 +100,79 @@ std::optional<types::Clause> IUnificator::Resolution(types::Clause lhs,
   for (std::size_t i = 0; i < lhs.atoms().size(); ++i) {
     for (std::size_t j = 0; j < rhs.atoms().size(); ++j) {
       if ((lhs.atoms()[i].negative() + rhs.atoms()[j].negative()) % 2 == 1) {
-        auto sub = Unificate(lhs.atoms()[i], rhs.atoms()[j]);
+        auto sub = CachedUnificate(lhs.atoms()[i], rhs.atoms()[j]);
 
         if (!sub) {
           continue;
         }
 
-        auto cpy_lhs = lhs;
-        auto cpy_rhs = rhs;
-
-        cpy_lhs.EraseAtom(i);
-        cpy_rhs.EraseAtom(j);
-
-        cpy_lhs += cpy_rhs;
-
-        sub->Substitute(cpy_lhs);
-
-        Simplify(cpy_lhs);
-
+        auto resolvent = Resolve(lhs, i, rhs, j, *sub);
         std::cout << "Resolution: " << lhs << " RESOLVE " << rhs << " >>> "
-                  << cpy_lhs << '\n';
+                  << resolvent << '\n';
+        return resolvent;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<types::Clause> IUnificator::Resolution(
+    const types::Clause& lhs, std::size_t lhs_i, const types::Clause& rhs,
+    std::size_t rhs_i) const {
+  auto& lhs_atom = lhs.atoms()[lhs_i];
+  auto& rhs_atom = rhs.atoms()[rhs_i];
+  if (lhs_atom.negative() == rhs_atom.negative()) {
+    return std::nullopt;
+  }
+  auto sub = CachedUnificate(lhs_atom, rhs_atom);
+  if (!sub) {
+    return std::nullopt;
+  }
+  return Resolve(lhs, lhs_i, rhs, rhs_i, *sub);
+}
 
-        cpy_lhs.ClearAncestors();
-        cpy_lhs.GenerateId();
-        cpy_lhs.AddAncestor(lhs);
-        cpy_lhs.AddAncestor(rhs);
+std::vector<types::Clause> IUnificator::Resolutions(
+    const types::Clause& c,
+    const std::vector<const types::Clause*>& clauses) const {
+  FingerprintBlock block;
+  // literal of block -> (clause, literal in the clause)
+  std::vector<std::pair<std::size_t, std::size_t>> owners;
+  for (std::size_t k = 0; k < clauses.size(); ++k) {
+    for (std::size_t j = 0; j < clauses[k]->atoms().size(); ++j) {
+      block.Add(clauses[k]->atoms()[j]);
+      owners.emplace_back(k, j);
+    }
+  }
 
-        return cpy_lhs;
+  // the first resolved pair of literals for every clause, as in Resolution
+  std::vector<std::optional<std::tuple<std::size_t, std::size_t, Substitution>>>
+      first(clauses.size());
+  for (std::size_t i = 0; i < c.atoms().size(); ++i) {
+    for (auto& [literal, sub] : UnificateBatch(c.atoms()[i], block, true)) {
+      auto [k, j] = owners[literal];
+      if (!first[k]) {
+        first[k].emplace(i, j, std::move(sub));
       }
     }
   }
-  return std::nullopt;
+
+  std::vector<types::Clause> res;
+  for (std::size_t k = 0; k < clauses.size(); ++k) {
+    if (first[k]) {
+      auto& [i, j, sub] = *first[k];
+      res.push_back(Resolve(c, i, *clauses[k], j, sub));
+      std::cout << "Resolution: " << c << " RESOLVE " << *clauses[k]
+                << " >>> " << res.back() << '\n';
+    }
+  }
+
+  return res;
 }
 
 bool IUnificator::IsTautology(const types::Clause& c) const {
   for (auto& a_1 : c.atoms()) {
     for (auto& a_2 : c.atoms()) {
-      if (a_1.negative() != a_2.negative() && Unificate(a_1, a_2)) {
+      if (a_1.negative() != a_2.negative() && CachedUnificate(a_1, a_2)) {
         return true;
       }
     }
@@ -1,14 +1,19 @@
 #pragma once
 
+#include <libfol-basictypes/atom.hpp>
 #include <libfol-basictypes/clause.hpp>
 #include <libfol-basictypes/term.hpp>
 #include <libfol-basictypes/variable.hpp>
 #include <libfol-parser/parser/print.hpp>
-#include <libfol-transform/replace.hpp>
 #include <ostream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace fol::unification {
+// Binding environment: every variable is bound at most once and bound terms
+// may mention other bound variables, which are dereferenced when the
+// substitution is applied. Bindings are kept acyclic.
 class Substitution {
  public:
   struct SubstitutePair {
@@ -18,13 +23,15 @@ class Substitution {
     SubstitutePair(const SubstitutePair& o)
         : from(o.from), to(types::Clone(o.to)) {}
 
+    SubstitutePair(SubstitutePair&& o) = default;
+
     SubstitutePair(const types::Variable& from, const types::Term& to)
         : from(from), to(types::Clone(to)) {}
   };
 
   friend std::ostream& operator<<(std::ostream& os, const Substitution& sub) {
     os << "[ ";
-    for (auto& p : sub.substitute_pairs_) {
+    for (auto& p : sub.bindings_) {
       os << "{" << p.to << "/" << p.from << "} ";
     }
     os << "]";
@@ -33,64 +40,31 @@ class Substitution {
 
   Substitution() = default;
 
-  Substitution(const std::vector<SubstitutePair>& substitution)
-      : substitute_pairs_(substitution) {}
+  Substitution(std::vector<SubstitutePair> substitution);
 
-  Substitution& operator+=(const Substitution& o) {
-    for (auto& s_p : substitute_pairs_) {
-      o.Substitute(s_p.to);
-    }
+  Substitution& operator+=(const Substitution& o);
 
-    substitute_pairs_.reserve(substitute_pairs_.size() +
-                              o.substitute_pairs_.size());
+  const std::vector<SubstitutePair>& bindings() const { return bindings_; }
 
-    for (auto& o_s_p : o.substitute_pairs_) {
-      if (!std::any_of(substitute_pairs_.begin(), substitute_pairs_.end(),
-                       [&](auto&& s_p) { return s_p.from == o_s_p.from; })) {
-        substitute_pairs_.push_back(o_s_p);
-      }
-    }
+  const types::Term* Find(const types::Variable& var) const {
+    auto it = index_.find(var);
+    return it == index_.end() ? nullptr : &bindings_[it->second].to;
+  }
 
-    FilterUselessPairs();
+  types::Term Apply(const types::Term& term) const;
 
-    return *this;
-  }
+  types::Atom Apply(const types::Atom& atom) const;
 
-  void Substitute(types::Term& term) const {
-    for (auto&& sub_pair : substitute_pairs_) {
-      auto&& from = sub_pair.from;
-      auto&& to = sub_pair.to;
-      transform::ReplaceTermVar(term, from, to);
-    }
-  }
+  void Substitute(types::Term& term) const;
 
-  void Substitute(types::Atom& atom) const {
-    for (auto&& sub_pair : substitute_pairs_) {
-      atom.Substitute(sub_pair.from, sub_pair.to);
-    }
-  }
+  void Substitute(types::Atom& atom) const;
 
-  void Substitute(types::Clause& clause) const {
-    for (auto& atom : clause.atoms()) {
-      for (auto&& sub_pair : substitute_pairs_) {
-        atom.Substitute(sub_pair.from, sub_pair.to);
-      }
-    }
-  }
+  void Substitute(types::Clause& clause) const;
 
  private:
-  void FilterUselessPairs() {
-    std::vector<SubstitutePair> res;
-    res.reserve(substitute_pairs_.size());
-    for (auto& s_p : substitute_pairs_) {
-      if (!(s_p.to.IsVar() && s_p.from == s_p.to.Var())) {
-        res.push_back(s_p);
-      }
-    }
-
-    substitute_pairs_ = std::move(res);
-  }
+  void Bind(SubstitutePair pair);
 
-  std::vector<SubstitutePair> substitute_pairs_;
+  std::vector<SubstitutePair> bindings_;
+  std::unordered_map<types::Variable, std::size_t> index_;
 };
 }  // namespace fol::unification
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <libfol-basictypes/atom.hpp>
+#include <libfol-unification/substitution.hpp>
+#include <list>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol::unification {
+class IUnificator;
+
+// Bounded LRU cache of unification results. Literal pairs are keyed by their
+// text with variables numbered in order of first occurrence, so pairs equal
+// up to variable renaming share one entry.
+class UnificationCache {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 1 << 14;
+
+  struct Stats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+
+    double HitRate() const {
+      return hits + misses == 0 ? 0.
+                                : static_cast<double>(hits) /
+                                      static_cast<double>(hits + misses);
+    }
+  };
+
+  friend std::ostream& operator<<(std::ostream& os, const Stats& stats);
+
+  explicit UnificationCache(std::size_t capacity = kDefaultCapacity)
+      : capacity_(capacity) {}
+
+  std::optional<Substitution> Unificate(const types::Atom& lhs,
+                                        const types::Atom& rhs,
+                                        const IUnificator& unificator);
+
+  const Stats& stats() const { return stats_; }
+
+  std::size_t size() const { return entries_.size(); }
+
+  std::size_t capacity() const { return capacity_; }
+
+ private:
+  struct Entry {
+    std::string key;
+    bool unifiable;
+    // variable number -> term over numbered variables
+    std::vector<std::pair<std::size_t, types::Term>> mgu;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void Insert(Entry entry);
+
+  std::size_t capacity_;
+  Stats stats_;
+  EntryList entries_;
+  std::unordered_map<std::string_view, EntryList::iterator> index_;
+};
+}  // namespace fol::unification
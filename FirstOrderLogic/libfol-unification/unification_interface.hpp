@@ -2,8 +2,13 @@
 
 #include <libfol-basictypes/atom.hpp>
 #include <libfol-basictypes/clause.hpp>
+#include <libfol-unification/fingerprint.hpp>
 #include <libfol-unification/substitution.hpp>
+#include <libfol-unification/unification_cache.hpp>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace fol::unification {
 class IUnificator {
@@ -11,6 +16,21 @@ class IUnificator {
   virtual std::optional<Substitution> Unificate(const types::Atom&,
                                                 const types::Atom&) const = 0;
 
+  // Unificate through the shared cache, if there is one
+  std::optional<Substitution> CachedUnificate(const types::Atom& lhs,
+                                              const types::Atom& rhs) const;
+
+  void SetCache(std::shared_ptr<UnificationCache> cache) {
+    cache_ = std::move(cache);
+  }
+
+  // Unificate query with the literals of block that pass the fingerprint
+  // prefilter: of the opposite sign if complementary, of the same otherwise.
+  // Returns indices of unifiable literals with their unifiers.
+  std::vector<std::pair<std::size_t, Substitution>> UnificateBatch(
+      const types::Atom& query, const FingerprintBlock& block,
+      bool complementary) const;
+
   void Simplify(types::Clause& clause) const;
 
   bool IsPartOf(const types::Clause& lhs, const types::Clause& rhs) const;
@@ -18,6 +38,25 @@ class IUnificator {
   std::optional<types::Clause> Resolution(types::Clause lhs,
                                           types::Clause rhs) const;
 
+  // Resolvent on the lhs_i-th literal of lhs and the rhs_i-th literal of
+  // rhs, if they have opposite signs and unify. It is not printed.
+  std::optional<types::Clause> Resolution(const types::Clause& lhs,
+                                          std::size_t lhs_i,
+                                          const types::Clause& rhs,
+                                          std::size_t rhs_i) const;
+
+  // Resolution of c with each of clauses
+  std::vector<types::Clause> Resolutions(
+      const types::Clause& c,
+      const std::vector<const types::Clause*>& clauses) const;
+
   bool IsTautology(const types::Clause& c) const;
+
+ private:
+  types::Clause Resolve(const types::Clause& lhs, std::size_t lhs_i,
+                        const types::Clause& rhs, std::size_t rhs_i,
+                        const Substitution& sub) const;
+
+  std::shared_ptr<UnificationCache> cache_;
 };
 }  // namespace fol::unification
@@ -1,19 +1,32 @@
 #include <chrono>
+#include <cppcoro/generator.hpp>
+#include <cstdint>
 #include <cstdlib>
+#include <details/utils/parallel.hpp>
 #include <iostream>
 #include <libfol-basictypes/basic_clauses_storage.hpp>
 #include <libfol-basictypes/basic_clauses_storage_factory.hpp>
+#include <libfol-basictypes/clause_cache.hpp>
+#include <libfol-basictypes/cnf_reader.hpp>
 #include <libfol-basictypes/short_precedence_clauses_storage.hpp>
 #include <libfol-basictypes/short_precedence_clauses_storage_factory.hpp>
 #include <libfol-basictypes/strikeout_clauses_storage.hpp>
 #include <libfol-basictypes/strikeout_clauses_storage_factory.hpp>
 #include <libfol-basictypes/support_clauses_storage_factory.hpp>
 #include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/flat_ast.hpp>
 #include <libfol-parser/parser/parser.hpp>
+#include <libfol-parser/parser/problem_reader.hpp>
 #include <libfol-parser/parser/types.hpp>
+#include <libfol-prover/axiom_selection.hpp>
+#include <libfol-prover/preprocessor.hpp>
 #include <libfol-prover/prover.hpp>
 #include <libfol-transform/normalization.hpp>
+#include <libfol-transform/normalization_cache.hpp>
+#include <libfol-transform/normalization_context.hpp>
 #include <libfol-transform/normalized_formula.hpp>
+#include <libfol-unification/adaptive_unification_factory.hpp>
+#include <libfol-unification/caching_unification_factory.hpp>
 #include <libfol-unification/here_unification_factory.hpp>
 #include <libfol-unification/martelli_montanari_unification_factory.hpp>
 #include <libfol-unification/robinson_unification_factory.hpp>
@@ -21,6 +34,11 @@
 #include <memory>
 #include <numeric>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
 std::optional<fol::parser::FolFormula> Parse(std::string str) {
@@ -79,19 +97,261 @@ fol::parser::FolFormula ReadFormula() {
   return std::move(*formula);
 }
 
-std::vector<fol::types::Clause> ClausesFromFol(
-    fol::parser::FolFormula formula) {
-  std::vector<fol::types::Clause> res;
-  auto norm_formula = fol::transform::ToNormalizedFormula(
-      fol::transform::Normalize(std::move(formula)));
+// Clauses of a formula, each one made when the normalizer yields it
+cppcoro::generator<fol::types::Clause> ClausesFromFol(
+    fol::parser::FolFormula formula,
+    fol::transform::NormalizationCache& normalization_cache) {
+  for (auto& disj : normalization_cache.Clausify(std::move(formula))) {
+    fol::types::Clause clause{std::move(disj)};
+    co_yield clause;
+  }
+}
+
+// Clauses of the axioms and of the negated hypothesis
+using ProblemClauses = std::pair<std::vector<fol::types::Clause>,
+                                 std::vector<fol::types::Clause>>;
+
+// Key of the axiom clauses in a cache. The normalizer version and the mode
+// are part of the key as they decide the clauses and the fresh names.
+std::uint64_t AxiomsKey(const std::vector<fol::parser::FormulaSource>& axioms,
+                        std::string_view mode) {
+  auto key = fol::types::ContentHash(
+      std::to_string(fol::transform::kNormalizationVersion));
+  key = fol::types::ContentHash(mode, key);
+  for (auto& axiom : axioms) {
+    key = fol::types::ContentHash(axiom.text, key);
+    key = fol::types::ContentHash("\n", key);
+  }
+  return key;
+}
+
+std::optional<std::vector<fol::types::Clause>> LoadAxiomClauses(
+    const fol::types::ClauseCache& cache, std::uint64_t key) {
+  auto cached = cache.Load(key);
+  if (!cached) {
+    return std::nullopt;
+  }
+  fol::transform::NormalizationContext::Current().Skip(cached->names,
+                                                       cached->functions);
+  std::cout << "Axioms' clauses loaded from " << cache.Path(key) << std::endl;
+  return std::move(cached->clauses);
+}
+
+void StoreAxiomClauses(const fol::types::ClauseCache& cache,
+                       std::uint64_t key,
+                       std::vector<fol::types::Clause>& clauses) {
+  auto& context = fol::transform::NormalizationContext::Current();
+  fol::types::CachedClauses cached{std::move(clauses), context.names(),
+                                   context.functions()};
+  try {
+    cache.Store(key, cached);
+  } catch (const std::system_error& e) {
+    std::cerr << "Can not store axioms' clauses: " << e.what() << std::endl;
+  }
+  clauses = std::move(cached.clauses);
+}
+
+// Options of the axiom selection and how many axioms it dropped
+struct AxiomSelection {
+  fol::prover::SineOptions options;
+  std::size_t dropped = 0;
+};
+
+// Sources of the axioms that SInE selects for the hypothesis. If an axiom
+// does not parse, all of them are kept and the error is reported when they
+// are parsed for normalization.
+std::vector<fol::parser::FormulaSource> SelectAxioms(
+    std::vector<fol::parser::FormulaSource> sources,
+    const fol::parser::FolFormula& hypothesis, AxiomSelection& selection) {
+  fol::parser::flat::Ast ast;
+  std::vector<fol::parser::flat::NodeId> axioms;
+  axioms.reserve(sources.size());
+  for (auto& source : sources) {
+    try {
+      axioms.push_back(fol::parser::flat::ParseFlat(source.text, ast));
+    } catch (const fol::parser::flat::FlatParseError& e) {
+      std::cerr << "Axiom selection skipped, axiom at line " << source.line
+                << ": " << e.what() << std::endl;
+      return sources;
+    }
+  }
+  auto goal = fol::parser::flat::FromFol(hypothesis, ast);
+
+  auto selected =
+      fol::prover::SelectAxioms(ast, axioms, goal, selection.options);
+  std::cout << "Axiom selection: " << sources.size() << " -> "
+            << selected.size() << " axioms" << std::endl;
+  selection.dropped = sources.size() - selected.size();
+  std::vector<fol::parser::FormulaSource> res;
+  res.reserve(selected.size());
+  for (auto i : selected) {
+    res.push_back(sources[i]);
+  }
+  return res;
+}
+
+using ProblemClause = fol::prover::InputClause;
+
+// Clauses of the axioms, then of the negated hypothesis, as they are made
+cppcoro::generator<ProblemClause> ReadProblem(
+    const std::optional<std::string>& problem,
+    const std::optional<fol::types::ClauseCache>& cache,
+    AxiomSelection* selection) {
+  std::vector<fol::parser::FolFormula> axioms;
+  std::optional<fol::parser::FolFormula> last_formula;
+  std::optional<std::vector<fol::types::Clause>> cached_clauses;
+  std::uint64_t key = 0;
+  if (problem) {
+    fol::parser::ProblemReader reader{*problem};
+    std::vector<fol::parser::FormulaSource> sources;
+    while (auto axiom = reader.NextAxiom()) {
+      sources.push_back(*axiom);
+    }
+    last_formula = reader.Parse(reader.Hypothesis());
+    if (selection) {
+      sources = SelectAxioms(std::move(sources), *last_formula, *selection);
+    }
+    if (cache) {
+      key = AxiomsKey(sources, "sequential");
+      cached_clauses = LoadAxiomClauses(*cache, key);
+    }
+    if (!cached_clauses) {
+      axioms.reserve(sources.size());
+      for (auto& source : sources) {
+        axioms.push_back(reader.Parse(source));
+      }
+    }
+  } else {
+    std::cout << "Enter axioms' number: ";
+    const int axioms_count = input<int>(std::cin);
+    axioms.reserve(axioms_count);
+
+    for (int i = 0; i < axioms_count; ++i) {
+      axioms.push_back(ReadFormula());
+    }
+  }
+
+  fol::transform::NormalizationCache normalization_cache;
+  if (cached_clauses) {
+    for (auto& clause : *cached_clauses) {
+      ProblemClause problem_clause{std::move(clause), false};
+      co_yield problem_clause;
+    }
+  } else {
+    // a copy of the axioms' clauses is kept only to be stored
+    const bool store = cache.has_value() && problem.has_value();
+    std::vector<fol::types::Clause> axiom_clauses;
+    for (auto& a : axioms) {
+      std::cout << "Axiom: " << a << std::endl;
+      for (auto& clause : ClausesFromFol(std::move(a), normalization_cache)) {
+        if (store) {
+          axiom_clauses.push_back(clause);
+        }
+        ProblemClause problem_clause{std::move(clause), false};
+        co_yield problem_clause;
+      }
+    }
+    if (store) {
+      StoreAxiomClauses(*cache, key, axiom_clauses);
+    }
+  }
 
-  std::cout << "Normalized and skolemized formula: " << norm_formula
+  if (!last_formula) {
+    std::cout << "Enter hypothesis: ";
+    last_formula = ReadLastFormula();
+  }
+  fol::parser::FolFormula hypothesis = ToFol(~!std::move(*last_formula));
+  for (auto& clause :
+       ClausesFromFol(std::move(hypothesis), normalization_cache)) {
+    ProblemClause problem_clause{std::move(clause), true};
+    co_yield problem_clause;
+  }
+  std::cout << "Normalization cache: " << normalization_cache.stats().hits
+            << " hits, " << normalization_cache.stats().misses << " misses"
             << std::endl;
-  auto disjs = norm_formula.GetDisjunctions();
-  res.reserve(disjs.size());
+}
+
+struct ClausifiedFormula {
+  std::string formula;
+  std::vector<fol::parser::FolFormula> disjunctions;
+};
+
+// Reads the whole problem first, then parses and clausifies its formulas on
+// a pool of jobs threads, their CNF conversion runs on the same pool. Every
+// formula takes fresh names from a context of its own, so names do not depend
+// on scheduling. Clauses are built in formula order on this thread to keep
+// their ids deterministic.
+ProblemClauses ReadProblemParallel(
+    const std::optional<std::string>& problem, std::size_t jobs,
+    const std::optional<fol::types::ClauseCache>& cache,
+    AxiomSelection* selection) {
+  std::optional<fol::parser::ProblemReader> reader;
+  std::vector<fol::parser::FormulaSource> sources;
+  std::vector<fol::parser::FolFormula> formulas;
+  ProblemClauses res;
+  std::size_t first = 0;
+  std::uint64_t key = 0;
+  if (problem) {
+    reader.emplace(*problem);
+    while (auto axiom = reader->NextAxiom()) {
+      sources.push_back(*axiom);
+    }
+    auto hypothesis = reader->Hypothesis();
+    if (selection) {
+      sources = SelectAxioms(std::move(sources), reader->Parse(hypothesis),
+                             *selection);
+    }
+    if (cache) {
+      key = AxiomsKey(sources, "parallel");
+      if (auto cached_clauses = LoadAxiomClauses(*cache, key)) {
+        res.first = std::move(*cached_clauses);
+        first = sources.size();
+      }
+    }
+    sources.push_back(hypothesis);
+  } else {
+    std::cout << "Enter axioms' number: ";
+    const int axioms_count = input<int>(std::cin);
+    formulas.reserve(axioms_count + 1);
+    for (int i = 0; i < axioms_count; ++i) {
+      formulas.push_back(ReadFormula());
+    }
+    std::cout << "Enter hypothesis: ";
+    formulas.push_back(ReadLastFormula());
+  }
+
+  const auto count = reader ? sources.size() : formulas.size();
+  std::vector<ClausifiedFormula> clausified(count);
+  fol::details::utils::TaskPool pool{jobs};
+  pool.ForEach(count - first, [&](std::size_t i) {
+    i += first;
+    fol::transform::NormalizationContext context{"a" + std::to_string(i) +
+                                                 "x"};
+    fol::transform::NormalizationContext::Scope scope{context};
+
+    auto formula =
+        reader ? reader->Parse(sources[i]) : std::move(formulas[i]);
+    if (i + 1 == count) {
+      formula = ToFol(~!std::move(formula));
+    }
+    clausified[i].formula = fol::parser::ToString(formula);
+
+    auto norm_formula = fol::transform::ToNormalizedFormula(
+        fol::transform::Normalize(std::move(formula)));
+    clausified[i].disjunctions = std::move(norm_formula).GetDisjunctions();
+  });
 
-  for (auto& disj : disjs) {
-    res.push_back(std::move(disj));
+  for (std::size_t i = first; i < count; ++i) {
+    auto& clauses = i + 1 == count ? res.second : res.first;
+    if (i + 1 < count) {
+      std::cout << "Axiom: " << clausified[i].formula << std::endl;
+    }
+    for (auto& disj : clausified[i].disjunctions) {
+      clauses.emplace_back(std::move(disj));
+    }
+  }
+  if (cache.has_value() && reader.has_value() && first == 0) {
+    StoreAxiomClauses(*cache, key, res.first);
   }
 
   return res;
@@ -106,7 +366,8 @@ void CollectAncestors(const fol::types::Clause& clause,
   map[clause.id()] = clause;
 }
 
-void PrintProof(const fol::types::Clause& clause) {
+// Clauses made after first_id belong to the attempt that found the proof
+void PrintProof(const fol::types::Clause& clause, std::size_t first_id) {
   std::map<std::size_t, fol::types::Clause> map;
   CollectAncestors(clause, map);
 
@@ -124,21 +385,90 @@ void PrintProof(const fol::types::Clause& clause) {
   }
 
   std::cout << "Proof size: " << map.size() << std::endl;
-  std::cout << "Useless clauses: " << clause.id() - map.size() << std::endl;
+  std::cout << "Useless clauses: " << clause.id() - first_id - map.size()
+            << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+  std::optional<std::string> problem;
+  std::optional<std::size_t> jobs;
+  std::optional<fol::types::ClauseCache> cache;
+  bool cnf = false;
+  bool preprocess = false;
+  bool sine = false;
+  fol::prover::SineOptions sine_options;
+  fol::unification::AdaptiveUnificator::Thresholds adaptive_thresholds;
+  bool usage_error = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "--cnf") {
+      cnf = true;
+    } else if (arg == "--preprocess") {
+      preprocess = true;
+    } else if (arg == "--sine") {
+      sine = true;
+    } else if (arg == "--sine-depth" && i + 1 < argc) {
+      sine = true;
+      sine_options.depth = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--sine-tolerance" && i + 1 < argc) {
+      sine = true;
+      sine_options.tolerance = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--adaptive-depth" && i + 1 < argc) {
+      adaptive_thresholds.robinson_depth = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--adaptive-weight" && i + 1 < argc) {
+      adaptive_thresholds.robinson_weight =
+          std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--adaptive-vars" && i + 1 < argc) {
+      adaptive_thresholds.here_vars = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--jobs" && i + 1 < argc) {
+      jobs = std::strtoul(argv[++i], nullptr, 10);
+      if (*jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+      }
+    } else if (arg == "--cache-dir" && i + 1 < argc) {
+      cache.emplace(argv[++i], fol::transform::kNormalizationVersion);
+    } else if (!problem && !arg.starts_with("--")) {
+      problem = arg;
+    } else {
+      usage_error = true;
+    }
+  }
+  const bool needs_problem = cnf || cache.has_value() || sine;
+  if (usage_error ||
+      (cnf && (jobs.has_value() || cache.has_value() || sine)) ||
+      (needs_problem && !problem)) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--preprocess] [--jobs N] [problem]\n"
+              << "       " << argv[0]
+              << " [--preprocess] [--jobs N] [--cache-dir DIR]"
+                 " [--sine] [--sine-depth N] [--sine-tolerance T] problem\n"
+              << "       " << argv[0] << " [--preprocess] --cnf problem\n"
+              << "Every form also takes [--adaptive-depth N]"
+                 " [--adaptive-weight N] [--adaptive-vars N]\n";
+    return EXIT_FAILURE;
+  }
+
   std::cout << "Choose unification algorithm:\n"
                "[1] Robinson unification\n"
                "[2] Here unification\n"
-               "[3] Martelli-Montanari unification\n";
+               "[3] Martelli-Montanari unification\n"
+               "[4] Adaptive unification\n";
+  auto adaptive_factory =
+      std::make_shared<fol::unification::AdaptiveUnificatorFactory>(
+          adaptive_thresholds);
   std::shared_ptr<fol::unification::IUnificatorFactory> unification_factories[]{
       std::make_shared<fol::unification::RobinsonUnificatorFactory>(),
       std::make_shared<fol::unification::HereUnificatorFactory>(),
-      std::make_shared<fol::unification::MartelliMontanariUnificatorFactory>()};
+      std::make_shared<fol::unification::MartelliMontanariUnificatorFactory>(),
+      adaptive_factory};
 
+  const int unification_choice = input<int>(std::cin);
+  auto unification_cache =
+      std::make_shared<fol::unification::UnificationCache>();
   auto unification_factory =
-      std::move(unification_factories[input<int>(std::cin) - 1]);
+      std::make_shared<fol::unification::CachingUnificatorFactory>(
+          std::move(unification_factories[unification_choice - 1]),
+          unification_cache);
 
   std::cout << "Choose clause choosing policy:\n"
                "[1] Saturation policy\n"
@@ -162,56 +492,104 @@ int main() {
   auto clauses_storage_factory =
       std::move(clauses_storage_factories[input<int>(std::cin) - 1]);
 
-  std::cout << "Enter axioms' number: ";
-  const int axioms_count = input<int>(std::cin);
-  std::vector<fol::parser::FolFormula> axioms;
-  axioms.reserve(axioms_count);
-
-  for (int i = 0; i < axioms_count; ++i) {
-    axioms.push_back(ReadFormula());
-  }
-
-  std::vector<fol::types::Clause> axiom_clauses;
-
-  for (auto& a : axioms) {
-    std::cout << "Axiom: " << a << std::endl;
-    auto a_cls = ClausesFromFol(std::move(a));
-    axiom_clauses.insert(axiom_clauses.cend(), a_cls.begin(), a_cls.end());
-  }
-
-  std::cout << "Enter hypothesis: ";
-  fol::parser::FolFormula hypothesis = ToFol(~!ReadLastFormula());
-  auto hypothesis_clauses = ClausesFromFol(std::move(hypothesis));
-
   auto tm_un = unification_factory->create();
+  // Saturation time of all attempts
+  std::chrono::duration<double> elapsed_seconds{};
+  std::size_t first_id = 0;
+  bool retried = false;
+  // Proof from the clauses of the problem, only of the axioms that SInE
+  // selects if selection is given
+  auto prove =
+      [&](AxiomSelection* selection) -> std::optional<fol::types::Clause> {
+    first_id = fol::types::Clause::last_id();
+    // Input clauses are simplified and stored as soon as they are made, or
+    // after all of them are preprocessed
+    auto clauses_storages = clauses_storage_factory->create();
+    std::vector<fol::prover::InputClause> input_clauses;
+    auto insert = [&](fol::types::Clause& c, bool hypothesis) {
+      tm_un->Simplify(c);
+      std::cout << "[" << c.id() << "] " << c << std::endl;
+      if (preprocess) {
+        input_clauses.push_back({std::move(c), hypothesis});
+      } else {
+        clauses_storage_factory->Insert(clauses_storages, c, hypothesis);
+      }
+    };
+    auto insert_all = [&](ProblemClauses problem_clauses) {
+      for (auto& c : problem_clauses.first) {
+        insert(c, false);
+      }
+      for (auto& c : problem_clauses.second) {
+        insert(c, true);
+      }
+    };
 
-  for (auto& c : axiom_clauses) {
-    tm_un->Simplify(c);
-    std::cout << "[" << c.id() << "] " << c << std::endl;
-  }
+    if (cnf) {
+      auto cnf_problem = fol::types::CnfReader{*problem}.Read();
+      insert_all({std::move(cnf_problem.axioms),
+                  std::move(cnf_problem.hypothesis)});
+    } else if (jobs) {
+      insert_all(ReadProblemParallel(problem, *jobs, cache, selection));
+    } else {
+      for (auto& [clause, hypothesis] :
+           ReadProblem(problem, cache, selection)) {
+        insert(clause, hypothesis);
+      }
+    }
 
-  for (auto& c : hypothesis_clauses) {
-    tm_un->Simplify(c);
-    std::cout << "[" << c.id() << "] " << c << std::endl;
-  }
+    if (preprocess) {
+      fol::prover::Preprocessor preprocessor{unification_factory->create()};
+      const auto input_size = input_clauses.size();
+      input_clauses = preprocessor.Run(std::move(input_clauses));
+      std::cout << "Preprocessing: " << input_size << " -> "
+                << input_clauses.size() << " clauses, removed "
+                << preprocessor.stats() << std::endl;
+      if (input_clauses.size() == 1 && input_clauses.front().clause.empty()) {
+        return std::move(input_clauses.front().clause);
+      }
+      for (auto& [clause, hypothesis] : input_clauses) {
+        clauses_storage_factory->Insert(clauses_storages, clause, hypothesis);
+      }
+    }
 
-  auto clauses_storages = clauses_storage_factory->create(
-      std::move(axiom_clauses), std::move(hypothesis_clauses));
+    auto prover = fol::prover::Prover(unification_factory->create(),
+                                      std::move(clauses_storages.first),
+                                      std::move(clauses_storages.second));
 
-  auto prover = fol::prover::Prover(unification_factory->create(),
-                                    std::move(clauses_storages.first),
-                                    std::move(clauses_storages.second));
+    auto start = std::chrono::steady_clock::now();
+    auto res = prover.Prove();
+    auto end = std::chrono::steady_clock::now();
+    elapsed_seconds += end - start;
+    return res;
+  };
 
-  auto start = std::chrono::steady_clock::now();
-  auto res = prover.Prove();
-  auto end = std::chrono::steady_clock::now();
+  std::optional<fol::types::Clause> res;
+  try {
+    AxiomSelection selection{sine_options};
+    res = prove(sine ? &selection : nullptr);
+    // saturation without some of the axioms does not refute the problem
+    if (!res && selection.dropped > 0) {
+      std::cout << "No proof from the selected axioms, retrying with all"
+                << std::endl;
+      retried = true;
+      res = prove(nullptr);
+    }
+  } catch (const fol::parser::ProblemError& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
 
   if (res) {
-    PrintProof(*res);
+    PrintProof(*res, first_id);
   } else {
     std::cout << "No proof" << std::endl;
   }
 
-  std::chrono::duration<double> elapsed_seconds = end - start;
-  std::cout << "Elapsed time: " << 1000 * elapsed_seconds.count() << "ms\n";
+  std::cout << "Elapsed time: " << 1000 * elapsed_seconds.count() << "ms"
+            << (retried ? " (both attempts)" : "") << '\n';
+  std::cout << "Unification cache: " << unification_cache->stats() << '\n';
+  if (unification_choice == 4) {
+    std::cout << "Adaptive unification (" << adaptive_factory->thresholds()
+              << "): " << adaptive_factory->stats() << '\n';
+  }
 }
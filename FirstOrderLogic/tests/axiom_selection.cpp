@@ -0,0 +1,32 @@
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <libfol-parser/parser/flat_ast.hpp>
+#include <libfol-prover/axiom_selection.hpp>
+#include <vector>
+
+using namespace fol;
+
+TEST_CASE("sine axiom selection", "[prover][fol]") {
+  parser::flat::Ast ast;
+  std::vector<parser::flat::NodeId> axioms;
+  for (auto axiom : {"pP(cA) -> pQ(cA)", "@vx.(pQ(vx) -> pR(vx))",
+                     "@vx.(pS(vx) -> pT(vx))", "pR(cB)"}) {
+    axioms.push_back(parser::flat::ParseFlat(axiom, ast));
+  }
+  using Selected = std::vector<std::size_t>;
+
+  // pR occurs in more axioms than cB, so it does not trigger pR(cB)
+  auto hypothesis = parser::flat::ParseFlat("pR(cA)", ast);
+  REQUIRE(prover::SelectAxioms(ast, axioms, hypothesis) == Selected{0, 1});
+  REQUIRE(prover::SelectAxioms(ast, axioms, hypothesis, {.tolerance = 2}) ==
+          Selected{0, 1, 3});
+
+  // pP triggers the first axiom, whose pQ triggers the second one
+  hypothesis = parser::flat::ParseFlat("pP(cC)", ast);
+  REQUIRE(prover::SelectAxioms(ast, axioms, hypothesis) == Selected{0, 1});
+  REQUIRE(prover::SelectAxioms(ast, axioms, hypothesis, {.depth = 1}) ==
+          Selected{0});
+
+  hypothesis = parser::flat::ParseFlat("pU(cC)", ast);
+  REQUIRE(prover::SelectAxioms(ast, axioms, hypothesis).empty());
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <libfol-basictypes/clause_cache.hpp>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fol;
+
+namespace {
+types::CachedClauses MakeClauses() {
+  types::CachedClauses cached;
+  cached.clauses.emplace_back(
+      parser::Parse(lexer::Tokenize("pP(vx, fF(cA, fG(vx))) or ~pQ(cA)")));
+  cached.clauses.emplace_back(parser::Parse(lexer::Tokenize("~pP(cB, vy)")));
+  cached.names = 7;
+  cached.functions = 2;
+  return cached;
+}
+
+std::vector<std::string> ToStrings(const std::vector<types::Clause>& clauses) {
+  std::vector<std::string> res;
+  for (auto& c : clauses) {
+    std::ostringstream os;
+    os << c;
+    res.push_back(os.str());
+  }
+  return res;
+}
+}  // namespace
+
+TEST_CASE("content hash", "[basictypes][fol]") {
+  REQUIRE(types::ContentHash("") == 0xcbf29ce484222325);
+  REQUIRE(types::ContentHash("a") == 0xaf63dc4c8601ec8c);
+  REQUIRE(types::ContentHash("b", types::ContentHash("a")) ==
+          types::ContentHash("ab"));
+}
+
+TEST_CASE("clause images", "[basictypes][fol]") {
+  auto cached = MakeClauses();
+  auto image = types::Serialize(42, 1, cached);
+
+  auto loaded = types::Deserialize(image, 42, 1);
+  REQUIRE(loaded.has_value());
+  REQUIRE(ToStrings(loaded->clauses) == ToStrings(cached.clauses));
+  REQUIRE(loaded->clauses == cached.clauses);
+  REQUIRE(loaded->clauses[0].atoms()[0].info().depth ==
+          cached.clauses[0].atoms()[0].info().depth);
+  REQUIRE(loaded->names == 7);
+  REQUIRE(loaded->functions == 2);
+
+  REQUIRE_FALSE(types::Deserialize(image, 43, 1).has_value());
+  REQUIRE_FALSE(types::Deserialize(image, 42, 2).has_value());
+  for (std::size_t size = 0; size < image.size(); ++size) {
+    REQUIRE_FALSE(
+        types::Deserialize(image.substr(0, size), 42, 1).has_value());
+  }
+  REQUIRE_FALSE(types::Deserialize(image + '\0', 42, 1).has_value());
+}
+
+TEST_CASE("clause cache directory", "[basictypes][fol]") {
+  auto directory = std::filesystem::temp_directory_path() / "fol_clause_cache";
+  std::filesystem::remove_all(directory);
+  types::ClauseCache cache{directory.string(), 1};
+
+  REQUIRE_FALSE(cache.Load(1).has_value());
+  cache.Store(1, MakeClauses());
+  auto loaded = cache.Load(1);
+  REQUIRE(loaded.has_value());
+  REQUIRE(ToStrings(loaded->clauses) == ToStrings(MakeClauses().clauses));
+  REQUIRE_FALSE(cache.Load(2).has_value());
+
+  // an image written by another version is a miss
+  types::ClauseCache other_version{directory.string(), 2};
+  REQUIRE_FALSE(other_version.Load(1).has_value());
+  other_version.Store(1, MakeClauses());
+  REQUIRE(other_version.Load(1).has_value());
+  REQUIRE_FALSE(cache.Load(1).has_value());
+
+  std::filesystem::remove_all(directory);
+}
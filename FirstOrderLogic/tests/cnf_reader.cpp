@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+#include <libfol-basictypes/cnf_reader.hpp>
+#include <libfol-transform/normalization_context.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fol;
+
+namespace {
+std::vector<std::string> ToStrings(const std::vector<types::Clause>& clauses) {
+  std::vector<std::string> res;
+  for (auto& c : clauses) {
+    std::ostringstream os;
+    os << c;
+    res.push_back(os.str());
+  }
+  return res;
+}
+}  // namespace
+
+TEST_CASE("read cnf statements", "[basictypes][fol]") {
+  transform::NormalizationContext context;
+  transform::NormalizationContext::Scope scope{context};
+
+  auto problem = types::CnfReader{"p.cnf",
+                                  "% comment\n"
+                                  "cnf(a1, axiom, pP(vx) | ~pQ(fF(vx, cA))).\n"
+                                  "cnf(h, negated_conjecture, (~pP(cA))).\n"
+                                  "cnf(a2, hypothesis,\n"
+                                  "    pQ(vx) or pR(vy, vx)).\n"}
+                     .Read();
+  REQUIRE(ToStrings(problem.axioms) ==
+          std::vector<std::string>{"pP(vu1) or ~pQ(fF(vu1, cA))",
+                                   "pQ(vu2) or pR(vu3, vu2)"});
+  REQUIRE(ToStrings(problem.hypothesis) ==
+          std::vector<std::string>{"~pP(cA)"});
+}
+
+TEST_CASE("read cnf lines", "[basictypes][fol]") {
+  transform::NormalizationContext context;
+  transform::NormalizationContext::Scope scope{context};
+
+  auto problem =
+      types::CnfReader{"p", "1\n\npP(vx) | pQ(vx)\n~pP(cA)\n~pQ(cA)\n"}.Read();
+  REQUIRE(ToStrings(problem.axioms) ==
+          std::vector<std::string>{"pP(vu1) or pQ(vu1)"});
+  REQUIRE(ToStrings(problem.hypothesis) ==
+          std::vector<std::string>{"~pP(cA)", "~pQ(cA)"});
+}
+
+TEST_CASE("cnf errors", "[basictypes][fol]") {
+  REQUIRE_THROWS_WITH(types::CnfReader("p", "two\n").Read(),
+                      "p:1:1: expected the number of axiom clauses");
+  REQUIRE_THROWS_WITH(types::CnfReader("p", "2\npP(cA)\n").Read(),
+                      "p:3:1: expected 2 axiom clauses, found 1");
+  REQUIRE_THROWS_WITH(types::CnfReader("p", "1\npP(cA) and pQ(cA)\n").Read(),
+                      "p:2:8: expected or, | or the end of the clause");
+  REQUIRE_THROWS_WITH(
+      types::CnfReader("p", "cnf(a, axiom, pP(cA)).\ncnf(b, axiom, pP()).")
+          .Read(),
+      "p:2:18: expected a term");
+  REQUIRE_THROWS_WITH(types::CnfReader("p", "cnf(a, axiom, pP(cA))").Read(),
+                      "p:1:22: expected '.'");
+}
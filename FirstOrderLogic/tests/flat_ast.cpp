@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/flat_ast.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-parser/parser/print.hpp>
+
+using namespace fol;
+using parser::flat::NodeKind;
+
+TEST_CASE("flat ast parsing", "[parser][fol]") {
+  parser::flat::Ast ast;
+  auto root = parser::flat::ParseFlat(
+      "@vx.(pP(vx) and pQ(vx) and (pR(vx) and pS(fF(vx, cA)))) -> ~pT(vx)",
+      ast);
+
+  REQUIRE(ast[root].kind == NodeKind::FORALL);
+  REQUIRE(ast.Name(root) == "vx");
+  auto impl = ast.children(root).front();
+  REQUIRE(ast[impl].kind == NodeKind::IMPLIES);
+
+  auto conj = ast.children(impl)[0];
+  REQUIRE(ast[conj].kind == NodeKind::AND);
+  REQUIRE(ast.children(conj).size() == 4);
+  auto pred = ast.children(conj)[3];
+  REQUIRE(ast.Name(pred) == "pS");
+  auto fun = ast.children(pred).front();
+  REQUIRE(ast[fun].kind == NodeKind::FUNCTION);
+  REQUIRE(ast.children(fun).size() == 2);
+  REQUIRE(ast[ast.children(impl)[1]].kind == NodeKind::NOT);
+
+  REQUIRE(ast.symbols().Find("vx") == ast[root].symbol);
+
+  ast.Clear();
+  REQUIRE(ast.size() == 0);
+}
+
+TEST_CASE("flat ast errors", "[parser][fol]") {
+  parser::flat::Ast ast;
+  try {
+    parser::flat::ParseFlat("pP(vx) and pQ(vx", ast);
+    FAIL();
+  } catch (const parser::flat::FlatParseError& e) {
+    REQUIRE(e.position == 16);
+  }
+  REQUIRE_THROWS_AS(parser::flat::ParseFlat("pP(vx) pQ(vx)", ast),
+                    parser::ParseError);
+}
+
+TEST_CASE("flat ast conversions", "[parser][fol]") {
+  for (std::string str :
+       {"pP(vx) or pQ(cA) and ~pR(fF(vx))",
+        "pP(vx) -> pQ(vx) -> pR(vx)",
+        "?vx.pP(vx) and (@vy.pQ(vy)) or ~(pR(vx) -> pP(vx))"}) {
+    auto formula = parser::Parse(lexer::Tokenize(str));
+    parser::flat::Ast ast;
+    auto parsed = parser::flat::ParseFlat(str, ast);
+    auto converted = parser::flat::FromFol(formula, ast);
+
+    auto back = parser::flat::ToFol(ast, parsed);
+    REQUIRE(parser::ToString(parser::flat::ToFol(ast, converted)) ==
+            parser::ToString(back));
+    // brackets added on the way back are dropped again
+    auto reparsed = parser::flat::ParseFlat(parser::ToString(back), ast);
+    REQUIRE(parser::ToString(parser::flat::ToFol(ast, reparsed)) ==
+            parser::ToString(back));
+  }
+}
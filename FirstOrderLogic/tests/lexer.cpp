@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <catch2/catch.hpp>
 #include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/lexer/tokenizer.hpp>
 #include <variant>
 #include <vector>
 using namespace fol::lexer;
@@ -43,3 +44,51 @@ TEST_CASE("tokenize sequence", "[lexer][fol]") {
   REQUIRE(std::equal(vec.begin(), vec.end(), generator.begin()));
 }
 
+
+TEST_CASE("tokenizer spans and symbols", "[lexer][fol]") {
+  std::string_view source = "@vx.pP(vx, fF(vx)) -> ~pP(cA)";
+  SymbolTable symbols;
+  Tokenizer tokenizer{source, &symbols};
+
+  auto token = tokenizer.Next();
+  REQUIRE(token.kind == TokenKind::FORALL);
+  REQUIRE(token.symbol == kNoSymbol);
+
+  token = tokenizer.Next();
+  REQUIRE(token.kind == TokenKind::VARIABLE);
+  REQUIRE(tokenizer.Text(token) == "vx");
+  REQUIRE(token.span.begin == 1);
+  REQUIRE(token.span.end == 3);
+  auto vx = token.symbol;
+  REQUIRE(symbols.Name(vx) == "vx");
+
+  std::vector<Token> tokens;
+  while ((token = tokenizer.Next()).kind != TokenKind::EPS) {
+    tokens.push_back(token);
+  }
+  REQUIRE(tokens.size() == 16);
+  REQUIRE(std::count_if(tokens.begin(), tokens.end(), [&](auto &&t) {
+            return t.symbol == vx;
+          }) == 2);
+  REQUIRE(symbols.size() == 4);
+  REQUIRE(tokenizer.Next().kind == TokenKind::EPS);
+
+  Tokenizer other{"cA oops", &symbols};
+  REQUIRE(other.Next().symbol == symbols.Find("cA"));
+  REQUIRE_THROWS_AS(other.Next(), LexerError);
+  REQUIRE(other.position() == 3);
+}
+
+TEST_CASE("tokenizer agrees with tokenize", "[lexer][fol]") {
+  std::string source =
+      "cConst and pPredicate or vVariable @ fFunction ? fBar . -> ,";
+  Tokenizer tokenizer{source};
+  auto generator = Tokenize(source);
+  for (auto &lexeme : generator) {
+    auto token = tokenizer.Next();
+    REQUIRE(ToLexeme(token, tokenizer.Text(token)) == lexeme);
+    if (token.kind == TokenKind::EPS) {
+      break;
+    }
+  }
+}
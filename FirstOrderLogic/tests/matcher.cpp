@@ -2,6 +2,8 @@
 #include <catch2/catch.hpp>
 #include <libfol-matcher/check_matcher.hpp>
 #include <libfol-matcher/matcher.hpp>
+#include <libfol-matcher/rule_set.hpp>
+#include <libfol-matcher/view_matcher.hpp>
 #include <libfol-parser/lexer/lexer.hpp>
 #include <libfol-parser/parser/parser.hpp>
 #include <libfol-parser/parser/print.hpp>
@@ -225,3 +227,61 @@ TEST_CASE("test brackets matching", "[checker][matcher][fol]") {
   REQUIRE(Conj(Unary(), Unary()).match(std::move(fol)));
 }
 
+
+TEST_CASE("test view matchers", "[matcher][fol]") {
+  auto fol = Parse(lexer::Tokenize("~((pP1(vx) or pP2(vx) or pP3(vx)))"));
+  const auto text = ToString(fol);
+
+  std::optional<view::ConstFormulaView> const_lhs;
+  const auto& const_fol = fol;
+  REQUIRE(!view::Not(view::Conj(view::Bind(const_lhs), view::Anything()))
+               .match(view::ConstFormulaView{&const_fol}));
+  REQUIRE(view::Not(view::Disj(view::Bind(const_lhs), view::Anything()))
+              .match(view::ConstFormulaView{&const_fol}));
+  REQUIRE(const_lhs->AsUnary() != nullptr);
+  REQUIRE(ToString(fol) == text);
+
+  std::optional<view::FormulaView> lhs;
+  std::optional<view::FormulaView> rhs;
+  REQUIRE(view::Not(view::Disj(view::Bind(lhs), view::Bind(rhs)))
+              .match(view::FormulaView{&fol}));
+  REQUIRE(ToString(fol) == text);
+  REQUIRE(ToString(lhs->Take()) == "pP1(vx)");
+  REQUIRE(ToString(rhs->Take()) == "pP2(vx) or pP3(vx)");
+
+  fol = Parse(lexer::Tokenize("(@ vx . pP1(vx)) -> (? vy . pP2(vy))"));
+  std::optional<std::string> var;
+  REQUIRE(view::Impl(view::Forall(view::Bind(var), view::Bind(lhs)),
+                     view::Exists(view::Anything()))
+              .match(view::FormulaView{&fol}));
+  REQUIRE(var == "vx");
+  REQUIRE(ToString(lhs->Take()) == "pP1(vx)");
+}
+
+TEST_CASE("test rule set dispatch", "[matcher][fol]") {
+  std::optional<view::FormulaView> lhs;
+  std::optional<view::FormulaView> rhs;
+  auto rules = view::RuleSet{
+      view::On(view::Not(view::Not(view::Bind(rhs))),
+               [&] { return std::string{"not not"}; }),
+      view::On(view::Not(view::Disj(view::Bind(lhs), view::Bind(rhs))),
+               [&] { return std::string{"not or"}; }),
+      view::On(view::Disj(view::Bind(lhs), view::Bind(rhs)),
+               [&] { return ToString(lhs->Take()); }),
+      view::On(view::Anything(), [&] { return std::string{"anything"}; })};
+
+  using Rules = decltype(rules);
+  REQUIRE(Rules::Candidates(view::DISJ * view::kNodeKinds) == 0b1100);
+  REQUIRE(Rules::Candidates(view::NOT * view::kNodeKinds + view::NOT) ==
+          0b1001);
+  REQUIRE(Rules::Candidates(view::NOT * view::kNodeKinds + view::DISJ) ==
+          0b1010);
+  REQUIRE(Rules::Candidates(view::PRED * view::kNodeKinds) == 0b1000);
+
+  auto fol = Parse(lexer::Tokenize("~(~pP(vx))"));
+  REQUIRE(rules.Apply(view::FormulaView{&fol}) == "not not");
+  fol = Parse(lexer::Tokenize("~((pP(vx) and pQ(vx)))"));
+  REQUIRE(rules.Apply(view::FormulaView{&fol}) == "anything");
+  fol = Parse(lexer::Tokenize("((pP(vx) or pQ(vx)))"));
+  REQUIRE(rules.Apply(view::FormulaView{&fol}) == "pP(vx)");
+}
@@ -1,3 +1,182 @@
+#include <catch2/catch.hpp>
+#include <details/utils/parallel.hpp>
+#include <libfol-basictypes/clause.hpp>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-parser/parser/print.hpp>
+#include <libfol-transform/definitional_cnf.hpp>
+#include <libfol-transform/miniscope.hpp>
 #include <libfol-transform/normalization.hpp>
+#include <libfol-transform/normalization_cache.hpp>
+#include <libfol-transform/normalization_context.hpp>
+#include <libfol-transform/normalized_formula.hpp>
+#include <libfol-transform/prenex.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+using namespace fol;
 
+namespace {
+std::string ToString(const types::Clause& clause) {
+  std::ostringstream os;
+  os << clause;
+  return os.str();
+}
+
+types::Clause MakeClause(const std::string& str) {
+  return types::Clause{parser::Parse(lexer::Tokenize(str))};
+}
+}  // namespace
+
+TEST_CASE("disjunctions of a normalized formula", "[transform][fol]") {
+  auto normalized = transform::ToNormalizedFormula(parser::Parse(
+      lexer::Tokenize("@ vx . (pA(vx) or pB(vx)) and ((pC(vx) and pD(vx)))")));
+
+  auto copies = normalized.GetDisjunctions();
+  std::vector<std::string> strings;
+  for (auto& disj : copies) {
+    strings.push_back(parser::ToString(disj));
+  }
+  REQUIRE(strings ==
+          std::vector<std::string>{"pA(vx) or pB(vx)", "pC(vx)", "pD(vx)"});
+
+  auto moved = std::move(normalized).GetDisjunctions();
+  REQUIRE(moved.size() == copies.size());
+  for (std::size_t i = 0; i < moved.size(); ++i) {
+    REQUIRE(parser::ToString(moved[i]) == strings[i]);
+  }
+}
+
+TEST_CASE("clause from a disjunction", "[transform][fol]") {
+  REQUIRE(ToString(MakeClause("(pC(vx) or (~pB(vx) or pA(cA)))")) ==
+          ToString(MakeClause("pA(cA) or ~pB(vx) or pC(vx)")));
+  REQUIRE(ToString(MakeClause("~(~pA(fF(cA)))")) == "pA(fF(cA))");
+  REQUIRE(ToString(MakeClause("~(pA(cA))")) == "~pA(cA)");
+
+  REQUIRE_THROWS_AS(MakeClause("pA(cA) and pB(cA)"), std::invalid_argument);
+  REQUIRE_THROWS_AS(MakeClause("pA(cA) -> pB(cA)"), std::invalid_argument);
+  REQUIRE_THROWS_AS(MakeClause("~(pA(cA) or pB(cA))"), std::invalid_argument);
+  REQUIRE_THROWS_AS(MakeClause("@ vx . pA(vx)"), std::invalid_argument);
+}
+
+TEST_CASE("definitional clausification", "[transform][fol]") {
+  // distributes into 2^7 clauses
+  auto formula = parser::Parse(lexer::Tokenize(
+      "@ vx . (pA(vx) and pB(vx)) or (pC(vx) and pD(vx)) or "
+      "(pE(vx) and pF(vx)) or (pG(vx) and pH(vx)) or (pI(vx) and pJ(vx)) or "
+      "(pK(vx) and pL(vx)) or (pM(vx) and pN(vx))"));
+
+  REQUIRE_FALSE(transform::ToDefinitionalCNF(formula, 128).has_value());
+
+  auto cnf = transform::ToDefinitionalCNF(formula);
+  REQUIRE(cnf.has_value());
+  auto clauses =
+      transform::ToNormalizedFormula(std::move(*cnf)).GetDisjunctions();
+  REQUIRE(clauses.size() == 66);
+  std::size_t definitions = 0;
+  for (auto& clause : clauses) {
+    auto str = parser::ToString(clause);
+    definitions += str.starts_with("~pdef");
+    REQUIRE(str.find("pdef") != std::string::npos);
+  }
+  REQUIRE(definitions == 2);
+
+  auto normalized = transform::ToNormalizedFormula(transform::Normalize(
+      parser::Parse(lexer::Tokenize(parser::ToString(formula)))));
+  REQUIRE(normalized.GetDisjunctions().size() == 66);
+}
+
+TEST_CASE("prenex form", "[transform][fol]") {
+  transform::NormalizationContext context;
+  transform::NormalizationContext::Scope scope{context};
+  auto prenex = [](const std::string& str) {
+    return parser::ToString(transform::DeleteUselessBrackets(
+        transform::ToPrenex(parser::Parse(lexer::Tokenize(str)))));
+  };
+
+  REQUIRE(prenex("(@ vx . pF(vx)) and ~(@ vx . pH(vx) -> (? vy . pG(vy)))") ==
+          "(@ vx . (? vu1 . (@ vy . pF(vx) and ~(pH(vu1)->((pG(vy)))))))");
+  // free vx is not captured
+  REQUIRE(prenex("pH(vx) and (@ vx . pF(vx))") ==
+          "(@ vu2 . pH(vx) and pF(vu2))");
+  // vacuous quantifiers are dropped
+  REQUIRE(prenex("@ vx . @ vx . pF(vx)") == "(@ vu3 . pF(vu3))");
+  REQUIRE(prenex("pF(cA) or pH(cA)") == "pF(cA) or pH(cA)");
+}
+
+TEST_CASE("miniscoping before skolemization", "[transform][fol]") {
+  transform::NormalizationContext context;
+  transform::NormalizationContext::Scope scope{context};
+  auto normalize = [](const std::string& str) {
+    return parser::ToString(
+        transform::Normalize(parser::Parse(lexer::Tokenize(str))));
+  };
+
+  REQUIRE(parser::ToString(transform::DeleteUselessBrackets(
+              transform::Miniscope(parser::Parse(lexer::Tokenize(
+                  "@ vx . ? vy . pP(vx) and pQ(vy) or pR(vx)"))))) ==
+          "(@ vx . pP(vx) and (? vy . pQ(vy)) or pR(vx))");
+
+  // skolem constants instead of skolem functions of universals not used
+  REQUIRE(normalize("@ vx . ? vy . pP(vy) and pQ(vx)") ==
+          "(@ vx . pP(cu1) and pQ(vx))");
+  REQUIRE(normalize("@ vx . @ vz . ? vy . pR(vx, vy) and pS(vz)") ==
+          "(@ vx . (@ vz . pR(vx, funiq0(vx)) and pS(vz)))");
+  // the universal is not split over a disjunction
+  REQUIRE(normalize("@ vx . ? vy . pP(vx, vy) or pQ(vx)") ==
+          "(@ vx . pP(vx, funiq1(vx)) or pQ(vx))");
+}
+
+TEST_CASE("normalization cache", "[transform][fol]") {
+  transform::NormalizationContext context;
+  transform::NormalizationContext::Scope scope{context};
+  auto parse = [](const std::string& str) {
+    return parser::Parse(lexer::Tokenize(str));
+  };
+  auto to_string = [](cppcoro::generator<parser::FolFormula> clauses) {
+    std::string res;
+    for (auto& clause : clauses) {
+      res += (res.empty() ? "" : "; ") + parser::ToString(clause);
+    }
+    return res;
+  };
+
+  REQUIRE(transform::AlphaKey(parse("@ vx . ? vy . pP(vx, vy, vz)")) ==
+          transform::AlphaKey(parse("@ vy . ? vx . pP(vy, vx, vz)")));
+  REQUIRE(transform::AlphaKey(parse("@ vx . pP(vx, vz)")) !=
+          transform::AlphaKey(parse("@ vz . pP(vz, vx)")));
+
+  transform::NormalizationCache cache;
+  REQUIRE(to_string(cache.Clausify(
+              parse("(@ vx . ? vy . pP(vx, vy)) and pQ(cA)"))) ==
+          "pP(vx, funiq0(vx)); pQ(cA)");
+  // both conjuncts are hits, the skolem function is shared
+  REQUIRE(to_string(cache.Clausify(
+              parse("pQ(cA) and (@ vz . ? vx . pP(vz, vx))"))) ==
+          "pQ(cA); pP(vx, funiq0(vx))");
+  REQUIRE(cache.stats().hits == 2);
+  REQUIRE(cache.stats().misses == 2);
+}
+
+TEST_CASE("conjuncts converted on a task pool", "[transform][fol]") {
+  const std::string formula =
+      "@ vx . @ vy . (pP(vx) or pQ(vy) and pR(vx)) and "
+      "(pS(vy) and pT(vx) or pU(vx)) and ~(pV(vx) and pW(vy))";
+  auto normalize = [&] {
+    transform::NormalizationContext context;
+    transform::NormalizationContext::Scope scope{context};
+    return parser::ToString(
+        transform::Normalize(parser::Parse(lexer::Tokenize(formula))));
+  };
+
+  const auto sequential = normalize();
+  details::utils::TaskPool pool{4};
+  std::vector<std::string> parallel(3);
+  pool.ForEach(parallel.size(),
+               [&](std::size_t i) { parallel[i] = normalize(); });
+  for (auto& result : parallel) {
+    REQUIRE(result == sequential);
+  }
+}
@@ -0,0 +1,54 @@
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <details/utils/parallel.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace fol;
+
+TEST_CASE("task pool runs every call once", "[utils][fol]") {
+  details::utils::TaskPool pool{4};
+
+  // many small rounds, so that workers often wake up on published tasks
+  for (std::size_t round = 0; round < 200; ++round) {
+    std::vector<std::atomic<int>> calls(round % 7 + 1);
+    pool.ForEach(calls.size(), [&](std::size_t i) { ++calls[i]; });
+    for (auto& count : calls) {
+      REQUIRE(count == 1);
+    }
+  }
+
+  // tasks calling ForEach themselves
+  std::vector<std::atomic<int>> nested(8 * 8);
+  std::atomic<int> outside = 0;
+  pool.ForEach(8, [&](std::size_t i) {
+    if (details::utils::TaskPool::Current() != &pool) {
+      ++outside;
+    }
+    pool.ForEach(8, [&](std::size_t j) { ++nested[i * 8 + j]; });
+  });
+  REQUIRE(outside == 0);
+  for (auto& count : nested) {
+    REQUIRE(count == 1);
+  }
+  REQUIRE(details::utils::TaskPool::Current() == nullptr);
+}
+
+TEST_CASE("task pool rethrows the lowest failed call", "[utils][fol]") {
+  details::utils::TaskPool pool{3};
+  std::atomic<int> calls = 0;
+  try {
+    pool.ForEach(16, [&](std::size_t i) {
+      ++calls;
+      if (i % 5 == 3) {
+        throw std::runtime_error{std::to_string(i)};
+      }
+    });
+    FAIL("no exception");
+  } catch (const std::runtime_error& e) {
+    REQUIRE(std::string{e.what()} == "3");
+  }
+  REQUIRE(calls == 16);
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <libfol-basictypes/clause.hpp>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-prover/preprocessor.hpp>
+#include <libfol-unification/robinson_unification.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fol;
+
+namespace {
+prover::InputClause MakeInput(std::string str, bool hypothesis = false) {
+  return {types::Clause(parser::Parse(lexer::Tokenize(std::move(str)))),
+          hypothesis};
+}
+
+std::string ToString(const std::vector<prover::InputClause>& clauses) {
+  std::stringstream ss;
+  for (auto& input : clauses) {
+    ss << input.clause << (input.hypothesis ? " H" : "") << "; ";
+  }
+  return ss.str();
+}
+}  // namespace
+
+TEST_CASE("preprocessing of the input clauses", "[prover][fol]") {
+  std::vector<prover::InputClause> clauses;
+  clauses.push_back(MakeInput("pP(vx) or ~pP(vx)"));
+  clauses.push_back(MakeInput("pQ(vx, cA) or ~pR(vx)"));
+  clauses.push_back(MakeInput("pQ(vy, cA) or ~pR(vy)", true));
+  clauses.push_back(MakeInput("pQ(vx, cA) or ~pR(vx) or pS(vx)"));
+  clauses.push_back(MakeInput("pR(cB)"));
+  clauses.push_back(MakeInput("~pQ(cB, cA) or pT(cC)"));
+  clauses.push_back(MakeInput("~pT(cC) or ~pR(cB)", true));
+
+  prover::Preprocessor preprocessor;
+  auto res = preprocessor.Run(std::move(clauses));
+  REQUIRE(preprocessor.stats().tautologies == 1);
+  REQUIRE(preprocessor.stats().duplicates == 1);
+  REQUIRE(preprocessor.stats().subsumed == 1);
+  // ~pR(cB), then ~pT(cC) becomes a unit and removes pT(cC)
+  REQUIRE(preprocessor.stats().propagated == 2);
+  // then pT only occurs negative
+  REQUIRE(preprocessor.stats().pure == 1);
+  REQUIRE(ToString(res) ==
+          "pQ(vx, cA) or ~pR(vx) H; pR(cB); ~pQ(cB, cA) H; ");
+
+  clauses.clear();
+  clauses.push_back(MakeInput("pP(cA)"));
+  clauses.push_back(MakeInput("~pP(cA) or pQ(cA)"));
+  clauses.push_back(MakeInput("~pQ(cA)", true));
+  res = prover::Preprocessor{}.Run(std::move(clauses));
+  REQUIRE(res.size() == 1);
+  REQUIRE(res.front().clause.empty());
+  REQUIRE(res.front().hypothesis);
+  // both literals of the middle clause are resolved at once
+  REQUIRE(res.front().clause.ancestors().size() == 3);
+
+  // pS only occurs positive, then pR only negative
+  clauses.clear();
+  clauses.push_back(MakeInput("pP(vx) or pS(vx)"));
+  clauses.push_back(MakeInput("~pP(cA) or ~pR(cA)"));
+  clauses.push_back(MakeInput("pP(vx)", true));
+  clauses.push_back(MakeInput("~pP(cB)"));
+  preprocessor = {};
+  res = preprocessor.Run(std::move(clauses));
+  REQUIRE(preprocessor.stats().subsumed == 1);
+  REQUIRE(preprocessor.stats().pure == 1);
+  REQUIRE(ToString(res) == "pP(vx) H; ~pP(cB); ");
+}
+
+TEST_CASE("elimination of predicates by resolution", "[prover][fol]") {
+  std::vector<prover::InputClause> clauses;
+  clauses.push_back(MakeInput("~pP(vx) or pD(vx)"));
+  clauses.push_back(MakeInput("~pD(vy) or pQ(vy)"));
+  clauses.push_back(MakeInput("pP(cA)"));
+  clauses.push_back(MakeInput("~pQ(cA)", true));
+
+  // pD, then pP are resolved away, resolving on pQ gives the empty clause
+  prover::Preprocessor preprocessor{
+      std::make_unique<unification::RobinsonUnificator>()};
+  auto res = preprocessor.Run(std::move(clauses));
+  REQUIRE(preprocessor.stats().eliminated == 2);
+  REQUIRE(res.size() == 1);
+  REQUIRE(res.front().clause.empty());
+  REQUIRE(res.front().hypothesis);
+  REQUIRE(res.front().clause.ancestors().size() == 2);
+
+  // 6 resolvents replace 5 clauses, the other predicates occur twice in a
+  // clause
+  auto make_clauses = [] {
+    std::vector<prover::InputClause> clauses;
+    clauses.push_back(MakeInput("pP(vx) or pQ(vx)"));
+    clauses.push_back(MakeInput("pP(vx) or pR(vx)"));
+    clauses.push_back(MakeInput("pP(vx) or pS(vx)"));
+    clauses.push_back(MakeInput("~pP(vy) or pT(vy)"));
+    clauses.push_back(MakeInput("~pP(vy) or pU(vy)", true));
+    for (auto predicate : {"pQ", "pR", "pS", "pT", "pU"}) {
+      clauses.push_back(MakeInput(std::string{predicate} + "(vx) or ~" +
+                                  predicate + "(fF(vx))"));
+    }
+    return clauses;
+  };
+  preprocessor =
+      prover::Preprocessor{std::make_unique<unification::RobinsonUnificator>()};
+  res = preprocessor.Run(make_clauses());
+  REQUIRE(preprocessor.stats().eliminated == 0);
+  REQUIRE(res.size() == 10);
+
+  preprocessor = prover::Preprocessor{
+      std::make_unique<unification::RobinsonUnificator>(), 2};
+  res = preprocessor.Run(make_clauses());
+  REQUIRE(preprocessor.stats().eliminated == 1);
+  REQUIRE(res.size() == 11);
+  auto hypothesis = std::count_if(res.begin(), res.end(), [](auto& input) {
+    return input.hypothesis;
+  });
+  REQUIRE(hypothesis == 3);
+}
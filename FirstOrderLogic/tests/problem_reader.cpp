@@ -0,0 +1,55 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-parser/parser/print.hpp>
+#include <libfol-parser/parser/problem_reader.hpp>
+
+using namespace fol;
+
+TEST_CASE("read problem", "[parser][fol]") {
+  parser::ProblemReader reader{
+      "problem.p", "2\npP(cA)\n\n  pQ(vx) \n\npR(vx)\n and pR(cB)\n"};
+  REQUIRE(reader.axioms_count() == 2);
+
+  auto axiom = reader.NextAxiom();
+  REQUIRE(axiom->text == "pP(cA)");
+  REQUIRE(axiom->line == 2);
+  axiom = reader.NextAxiom();
+  REQUIRE(axiom->text == "pQ(vx)");
+  REQUIRE(axiom->line == 4);
+  REQUIRE_FALSE(reader.NextAxiom().has_value());
+
+  auto hypothesis = reader.Hypothesis();
+  REQUIRE(hypothesis.line == 6);
+  REQUIRE(parser::ToString(reader.Parse(hypothesis)) ==
+          parser::ToString(parser::Parse(
+              lexer::Tokenize("pR(vx) and pR(cB)"))));
+}
+
+TEST_CASE("problem errors", "[parser][fol]") {
+  REQUIRE_THROWS_WITH(parser::ProblemReader("p", "two\n"),
+                      "p:1: expected the number of axioms");
+
+  parser::ProblemReader reader{"p", "2\npP(cA)\n\npQ(vx\n"};
+  reader.NextAxiom();
+  auto axiom = reader.NextAxiom();
+  REQUIRE_THROWS_WITH(reader.Parse(*axiom),
+                      "p:4:6: No close bracket at args for predicate.");
+  REQUIRE_THROWS_WITH(reader.Hypothesis(), "p:4: expected a hypothesis");
+
+  REQUIRE_THROWS_AS(parser::ProblemReader("/nonexistent/problem.p"),
+                    parser::ProblemError);
+}
+
+TEST_CASE("read mapped problem", "[parser][fol]") {
+  auto path = std::filesystem::temp_directory_path() / "fol_problem_test.p";
+  std::ofstream{path} << "1\npP(cA)\n~pP(cA)";
+
+  parser::ProblemReader reader{path.string()};
+  REQUIRE(reader.NextAxiom()->text == "pP(cA)");
+  REQUIRE(reader.Hypothesis().text == "~pP(cA)");
+
+  std::filesystem::remove(path);
+}
@@ -1,6 +1,9 @@
 #include <algorithm>
 #include <catch2/catch.hpp>
 #include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-parser/parser/print.hpp>
+#include <libfol-transform/normalization_context.hpp>
 #include <libfol-transform/replace.hpp>
 #include <variant>
 #include <vector>
@@ -11,12 +14,39 @@ TEST_CASE("rename var test", "[transform][fol]") {
   auto formula =
       parser::Parse(lexer::Tokenize("@ vx . pP(vx) -> pP(vy) and pP(vy)"));
   formula = transform::RenameVar(std::move(formula), "vx", "vy");
-  REQUIRE(parser::ToString(formula) == "((@ vy . pP(vy)->pP(vy) and pP(vy)))");
+  REQUIRE(parser::ToString(formula) == "(@ vy . pP(vy)->pP(vy) and pP(vy))");
   formula = transform::RenameVar(std::move(formula), "vx", "vy");
-  REQUIRE(parser::ToString(formula) ==
-          "(((@ vy . pP(vy)->pP(vy) and pP(vy))))");
+  REQUIRE(parser::ToString(formula) == "(@ vy . pP(vy)->pP(vy) and pP(vy))");
   formula = transform::RenameVar(std::move(formula), "vy", "vz");
-  REQUIRE(parser::ToString(formula) ==
-          "((((@ vz . pP(vz)->pP(vz) and pP(vz)))))");
+  REQUIRE(parser::ToString(formula) == "(@ vz . pP(vz)->pP(vz) and pP(vz))");
 }
 
+TEST_CASE("rename var keeps longer names", "[transform][fol]") {
+  auto formula =
+      parser::Parse(lexer::Tokenize("pP(vx, fF(vxy, vx)) and pQ(vxy)"));
+  formula = transform::RenameVar(std::move(formula), "vx", "vz");
+  REQUIRE(parser::ToString(formula) == "pP(vz, fF(vxy, vz)) and pQ(vxy)");
+
+  auto clone = transform::CloneFol(formula);
+  REQUIRE(clone == formula);
+  auto with_const = transform::ReplaceWithConst(formula, "vxy");
+  REQUIRE(parser::ToString(with_const).find("vxy") == std::string::npos);
+  REQUIRE(parser::ToString(formula) == "pP(vz, fF(vxy, vz)) and pQ(vxy)");
+}
+
+
+TEST_CASE("normalization context names", "[transform][fol]") {
+  transform::NormalizationContext context{"a0x"};
+  {
+    transform::NormalizationContext::Scope scope{context};
+    REQUIRE(transform::UniqFunName() == "funiqa0x0");
+    auto formula = parser::Parse(lexer::Tokenize("pP(vx)"));
+    formula = transform::Replace(std::move(formula), "vx");
+    REQUIRE(parser::ToString(formula) == "pP(vua0x1)");
+  }
+  REQUIRE(&transform::NormalizationContext::Current() != &context);
+
+  transform::NormalizationContext other{"a0x"};
+  transform::NormalizationContext::Scope scope{other};
+  REQUIRE(transform::UniqFunName() == "funiqa0x0");
+}
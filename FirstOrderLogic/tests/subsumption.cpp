@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+#include <libfol-basictypes/clause.hpp>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-unification/matching.hpp>
+
+using namespace fol;
+
+namespace {
+types::Clause MakeClause(std::string str) {
+  return types::Clause(parser::Parse(lexer::Tokenize(std::move(str))));
+}
+}  // namespace
+
+TEST_CASE("match terms", "[unification][fol]") {
+  auto pattern = types::Atom(parser::Parse(lexer::Tokenize("pP(vx, fF(vx))")));
+  auto target = types::Atom(parser::Parse(lexer::Tokenize("pP(cA, fF(cA))")));
+  unification::MatchBindings bindings;
+  REQUIRE(unification::Match(pattern, target, bindings));
+
+  bindings.Undo(0);
+  target = types::Atom(parser::Parse(lexer::Tokenize("pP(cA, fF(cB))")));
+  REQUIRE_FALSE(unification::Match(pattern, target, bindings));
+
+  bindings.Undo(0);
+  REQUIRE_FALSE(unification::Match(target, pattern, bindings));
+}
+
+TEST_CASE("subsumption", "[unification][fol]") {
+  REQUIRE(unification::Subsumes(MakeClause("pP(vx)"),
+                                MakeClause("pP(cA) or pQ(vy)")));
+  REQUIRE_FALSE(
+      unification::Subsumes(MakeClause("pP(cA)"), MakeClause("pP(vx)")));
+  REQUIRE_FALSE(
+      unification::Subsumes(MakeClause("pP(vx)"), MakeClause("~pP(cA)")));
+  REQUIRE(unification::Subsumes(MakeClause("pP(vx, vy) or pQ(vy)"),
+                                MakeClause("pQ(cB) or pP(cA, cB) or pR(cC)")));
+  REQUIRE_FALSE(unification::Subsumes(MakeClause("pP(vx, vy) or pQ(vy)"),
+                                      MakeClause("pQ(cA) or pP(cA, cB)")));
+  REQUIRE(unification::Subsumes(MakeClause("pP(vx) or pP(fF(vx))"),
+                                MakeClause("pP(cA) or pP(fF(cA))")));
+}
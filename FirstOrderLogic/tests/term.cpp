@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+#include <libfol-basictypes/atom.hpp>
+#include <libfol-basictypes/term.hpp>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-transform/replace.hpp>
+
+using namespace fol;
+
+namespace {
+types::Atom MakeAtom(std::string str) {
+  return types::Atom(parser::Parse(lexer::Tokenize(std::move(str))));
+}
+
+types::Term MakeVar(std::string_view name) {
+  return types::Term{lexer::Variable{name}};
+}
+}  // namespace
+
+TEST_CASE("term info", "[parser][fol]") {
+  auto atom = MakeAtom("pP(vx, fF(cA, vy))");
+  REQUIRE_FALSE(atom.info().ground);
+  REQUIRE(atom.info().depth == 2);
+  REQUIRE(atom.info().weight == 5);
+  REQUIRE(atom[1].info().vars == parser::VarBit("vy"));
+
+  atom.Substitute("vx", types::Term{lexer::Constant{std::string_view{"cB"}}});
+  atom.Substitute("vy", types::Clone(atom[0]));
+  REQUIRE(atom.info().ground);
+  REQUIRE(atom[1].info().ground);
+  REQUIRE(atom.info().weight == 5);
+}
+
+TEST_CASE("in-place changes keep term info current", "[parser][fol]") {
+  auto atom = MakeAtom("pP(fF(vx, fG(vy)))");
+  auto term = types::Clone(atom[0]);
+  REQUIRE(types::Contains(term, MakeVar("vy")));
+
+  // renaming a variable deep in the term
+  term.ModifyFunction([](parser::FunctionFormula& function) {
+    for (auto it = parser::FunctionTermsIt(function);
+         it != parser::TermListIt{}; ++it) {
+      transform::RenameVarInPlace(*it, "vy", "vz");
+    }
+  });
+  REQUIRE(term.info().vars & parser::VarBit("vz"));
+  REQUIRE(types::Contains(term, MakeVar("vz")));
+  REQUIRE_FALSE(types::Contains(term, MakeVar("vy")));
+
+  auto var = MakeVar("vx");
+  var.SetVar("vw");
+  REQUIRE(var.info().vars == parser::VarBit("vw"));
+
+  atom.ModifyTerms([&](types::Term& t) {
+    transform::ReplaceTerm(t, MakeVar("vx"), types::Clone(term));
+  });
+  REQUIRE(atom == MakeAtom("pP(fF(fF(vx, fG(vz)), fG(vy)))"));
+  REQUIRE(atom.info().depth == 4);
+  REQUIRE(types::Contains(atom[0], MakeVar("vz")));
+}
@@ -0,0 +1,356 @@
+#include <catch2/catch.hpp>
+#include <libfol-basictypes/clause.hpp>
+#include <libfol-parser/lexer/lexer.hpp>
+#include <libfol-parser/parser/parser.hpp>
+#include <libfol-unification/adaptive_unification.hpp>
+#include <libfol-unification/fingerprint.hpp>
+#include <libfol-unification/here_unification.hpp>
+#include <libfol-unification/martelli_montanari_unification.hpp>
+#include <libfol-unification/robinson_unification.hpp>
+#include <libfol-unification/unification_cache.hpp>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace fol;
+
+namespace {
+types::Atom MakeAtom(std::string str) {
+  return types::Atom(parser::Parse(lexer::Tokenize(std::move(str))));
+}
+
+// unifies lhs with rhs and checks that the unifier makes them equal
+bool Unifies(const unification::IUnificator& unificator, std::string lhs,
+             std::string rhs) {
+  auto lhs_atom = MakeAtom(std::move(lhs));
+  auto rhs_atom = MakeAtom(std::move(rhs));
+  auto sub = unificator.Unificate(lhs_atom, rhs_atom);
+  if (!sub) {
+    return false;
+  }
+  sub->Substitute(lhs_atom);
+  sub->Substitute(rhs_atom);
+  REQUIRE(lhs_atom == rhs_atom);
+  return true;
+}
+
+types::Clause MakeClause(std::string str) {
+  return types::Clause(parser::Parse(lexer::Tokenize(std::move(str))));
+}
+
+std::string Bound(const unification::Substitution& sub,
+                  const types::Variable& var) {
+  auto term = sub.Find(var);
+  if (!term) {
+    return "";
+  }
+  std::ostringstream os;
+  os << *term;
+  return os.str();
+}
+
+// unifies lhs with rhs through cache and checks that the unifier makes them
+// equal
+std::optional<unification::Substitution> CachedUnifies(
+    unification::UnificationCache& cache, std::string lhs, std::string rhs) {
+  auto lhs_atom = MakeAtom(std::move(lhs));
+  auto rhs_atom = MakeAtom(std::move(rhs));
+  auto sub = cache.Unificate(lhs_atom, rhs_atom,
+                             unification::RobinsonUnificator{});
+  if (sub) {
+    REQUIRE(sub->Apply(lhs_atom) == sub->Apply(rhs_atom));
+  }
+  return sub;
+}
+
+// binds every variable of lhs to a variable of its own
+class RenamingUnificator : public unification::IUnificator {
+ public:
+  std::optional<unification::Substitution> Unificate(
+      const types::Atom&, const types::Atom&) const override {
+    return unification::Substitution{
+        {{"vx", types::Term{lexer::Variable{std::string_view{"vfresh"}}}}}};
+  }
+};
+}  // namespace
+
+TEST_CASE("unificators agree", "[unification][fol]") {
+  unification::RobinsonUnificator robinson;
+  unification::HereUnificator here;
+  unification::MartelliMontanariUnificator martelli_montanari;
+  unification::AdaptiveUnificator adaptive(
+      {}, std::make_shared<unification::AdaptiveUnificator::Stats>());
+
+  for (const unification::IUnificator* unificator :
+       {static_cast<const unification::IUnificator*>(&robinson),
+        static_cast<const unification::IUnificator*>(&here),
+        static_cast<const unification::IUnificator*>(&martelli_montanari),
+        static_cast<const unification::IUnificator*>(&adaptive)}) {
+    REQUIRE(Unifies(*unificator, "pP(vx)", "pP(cA)"));
+    REQUIRE(Unifies(*unificator, "pP(fF(vx, vy))", "pP(fF(cA, cB))"));
+    REQUIRE(Unifies(*unificator, "pP(vx, vx)", "pP(vy, cA)"));
+    REQUIRE(Unifies(*unificator, "pP(fF(vx, vy), vy)",
+                    "pP(fF(fG(vz), vz), cA)"));
+    REQUIRE_FALSE(Unifies(*unificator, "pP(cA)", "pP(cB)"));
+    REQUIRE_FALSE(Unifies(*unificator, "pP(cA)", "pP(fF(vx))"));
+    REQUIRE_FALSE(Unifies(*unificator, "pP(vx, fF(vx))", "pP(cA, fF(cB))"));
+    REQUIRE_FALSE(Unifies(*unificator, "pP(fF(vx, cA))", "pP(fF(cB, vx))"));
+    REQUIRE_FALSE(Unifies(*unificator, "pP(vx, vy)", "pP(vy, fF(vx))"));
+  }
+}
+
+TEST_CASE("adaptive unificator dispatch", "[unification][fol]") {
+  using Algorithm = unification::AdaptiveUnificator::Algorithm;
+  unification::AdaptiveUnificator::Thresholds thresholds;
+
+  REQUIRE(unification::AdaptiveUnificator::Choose(
+              MakeAtom("pP(vx, cA)"), MakeAtom("pP(cB, vy)"), thresholds) ==
+          Algorithm::ROBINSON);
+  REQUIRE(unification::AdaptiveUnificator::Choose(
+              MakeAtom("pP(fF(fF(fF(vx))))"), MakeAtom("pP(vy)"),
+              thresholds) == Algorithm::MARTELLI_MONTANARI);
+  REQUIRE(unification::AdaptiveUnificator::Choose(
+              MakeAtom("pP(fF(fF(vx, vy)), vz)"),
+              MakeAtom("pP(vu, fF(vw, vv))"),
+              thresholds) == Algorithm::HERE);
+}
+
+TEST_CASE("unification cache renames cached unifiers", "[unification][fol]") {
+  unification::UnificationCache cache;
+
+  auto sub = CachedUnifies(cache, "pP(vx, fF(vy))", "pP(fG(vz), fF(vx))");
+  REQUIRE(sub.has_value());
+  REQUIRE(cache.stats().misses == 1);
+  REQUIRE(cache.size() == 1);
+
+  sub = CachedUnifies(cache, "pP(vu, fF(vw))", "pP(fG(vv), fF(vu))");
+  REQUIRE(sub.has_value());
+  REQUIRE(cache.stats().hits == 1);
+  REQUIRE(cache.size() == 1);
+  REQUIRE(Bound(*sub, "vu") == "fG(vv)");
+  REQUIRE(Bound(*sub, "vw") == "fG(vv)");
+  REQUIRE(Bound(*sub, "vx").empty());
+  REQUIRE(Bound(*sub, "vy").empty());
+
+  // a renaming that swaps the roles of the variables
+  sub = CachedUnifies(cache, "pP(vz, fF(vx))", "pP(fG(vy), fF(vz))");
+  REQUIRE(sub.has_value());
+  REQUIRE(cache.stats().hits == 2);
+  REQUIRE(Bound(*sub, "vz") == "fG(vy)");
+  REQUIRE(Bound(*sub, "vx") == "fG(vy)");
+  REQUIRE(Bound(*sub, "vy").empty());
+}
+
+TEST_CASE("unification cache keeps failures", "[unification][fol]") {
+  unification::UnificationCache cache;
+
+  REQUIRE_FALSE(CachedUnifies(cache, "pP(vx, fF(vx))", "pP(cA, fF(cB))"));
+  REQUIRE(cache.stats().misses == 1);
+  REQUIRE(cache.size() == 1);
+
+  REQUIRE_FALSE(CachedUnifies(cache, "pP(vy, fF(vy))", "pP(cA, fF(cB))"));
+  REQUIRE(cache.stats().hits == 1);
+  REQUIRE(cache.stats().misses == 1);
+  REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("unification cache evicts the oldest entry", "[unification][fol]") {
+  unification::UnificationCache cache{2};
+
+  REQUIRE(CachedUnifies(cache, "pP(vx)", "pP(cA)"));
+  REQUIRE(CachedUnifies(cache, "pP(vx)", "pP(cB)"));
+  REQUIRE(cache.stats().evictions == 0);
+  REQUIRE(CachedUnifies(cache, "pP(vx)", "pP(cC)"));
+  REQUIRE(cache.stats().misses == 3);
+  REQUIRE(cache.stats().evictions == 1);
+  REQUIRE(cache.size() == 2);
+
+  REQUIRE(CachedUnifies(cache, "pP(vy)", "pP(cB)"));
+  REQUIRE(CachedUnifies(cache, "pP(vy)", "pP(cC)"));
+  REQUIRE(cache.stats().hits == 2);
+
+  // the least recently used entry is pP(vx) = pP(cB)
+  auto sub = CachedUnifies(cache, "pP(vy)", "pP(cA)");
+  REQUIRE(sub.has_value());
+  REQUIRE(Bound(*sub, "vy") == "cA");
+  REQUIRE(cache.stats().misses == 4);
+  REQUIRE(cache.stats().evictions == 2);
+  REQUIRE(CachedUnifies(cache, "pP(vy)", "pP(cC)"));
+  REQUIRE(CachedUnifies(cache, "pP(vy)", "pP(cB)"));
+  REQUIRE(cache.stats().hits == 3);
+  REQUIRE(cache.stats().misses == 5);
+}
+
+TEST_CASE("unification cache skips invented variables",
+          "[unification][fol]") {
+  unification::UnificationCache cache;
+  RenamingUnificator unificator;
+  auto lhs = MakeAtom("pP(vx)");
+  auto rhs = MakeAtom("pP(vy)");
+
+  auto sub = cache.Unificate(lhs, rhs, unificator);
+  REQUIRE(sub.has_value());
+  REQUIRE(Bound(*sub, "vx") == "vfresh");
+  REQUIRE(cache.size() == 0);
+
+  sub = cache.Unificate(lhs, rhs, unificator);
+  REQUIRE(sub.has_value());
+  REQUIRE(Bound(*sub, "vx") == "vfresh");
+  REQUIRE(cache.stats().hits == 0);
+  REQUIRE(cache.stats().misses == 2);
+}
+
+TEST_CASE("fingerprint prefilter", "[unification][fol]") {
+  std::vector<types::Atom> atoms;
+  for (auto str :
+       {"pP(vx)", "~pP(vx)", "pP(cA)", "~pP(cB)", "pP(fF(vx))", "~pP(fF(cA))",
+        "pP(fG(vx))", "pQ(vx)", "~pQ(cA)", "pP(vx, cA)", "~pP(cA, vy)",
+        "pP(fF(vx), fG(vy))", "~pP(fF(cA), vy)", "pP(vx, vy)",
+        "pR(c1, c2, c3, c4, c5, c6, c7, c8)",
+        "~pR(c1, c2, c3, c4, c5, c6, c7, c9)",
+        "~pR(c1, vx, c3, c4, c5, c6, c7, vy)"}) {
+    atoms.push_back(MakeAtom(str));
+  }
+
+  unification::FingerprintBlock block;
+  block.reserve(atoms.size());
+  for (auto& atom : atoms) {
+    block.Add(atom);
+  }
+  REQUIRE(block.size() == atoms.size());
+
+  unification::RobinsonUnificator robinson;
+  for (auto& query : atoms) {
+    for (bool complementary : {false, true}) {
+      auto fingerprint = unification::MakeFingerprint(query, complementary);
+
+      std::vector<std::size_t> expected;
+      for (std::size_t i = 0; i < atoms.size(); ++i) {
+        if (unification::IsCompatible(fingerprint,
+                                      unification::MakeFingerprint(atoms[i]))) {
+          expected.push_back(i);
+        }
+      }
+      std::vector<std::size_t> survivors;
+      block.Filter(fingerprint, survivors);
+      REQUIRE(survivors == expected);
+
+      // no unifiable literal is filtered out
+      for (std::size_t i = 0; i < atoms.size(); ++i) {
+        if ((atoms[i].negative() != query.negative()) == complementary &&
+            robinson.Unificate(query, atoms[i])) {
+          REQUIRE(std::find(survivors.begin(), survivors.end(), i) !=
+                  survivors.end());
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("batch resolution", "[unification][fol]") {
+  unification::RobinsonUnificator robinson;
+  auto c = MakeClause("pP(vx) or ~pQ(vx, cA) or pR(fF(vx))");
+  std::vector<types::Clause> others;
+  for (auto str : {"~pP(cA) or pS(cB)", "pQ(cB, vy) or ~pP(fG(vy))",
+                   "pP(cA) or pR(cB)", "~pR(vz) or ~pP(vz)",
+                   "pQ(cA, cB) or pS(vu)", "~pR(fF(cC))"}) {
+    others.push_back(MakeClause(str));
+  }
+
+  std::vector<const types::Clause*> pointers;
+  std::vector<types::Clause> expected;
+  for (auto& d : others) {
+    pointers.push_back(&d);
+    if (auto resolvent = robinson.Resolution(c, d)) {
+      expected.push_back(std::move(*resolvent));
+    }
+  }
+
+  auto resolvents = robinson.Resolutions(c, pointers);
+  REQUIRE(resolvents.size() == 4);
+  REQUIRE(resolvents == expected);
+}
+
+TEST_CASE("substitution dereferences chained bindings", "[unification][fol]") {
+  unification::Substitution sub{
+      {{"vx", types::Term{lexer::Variable{std::string_view{"vy"}}}},
+       {"vy", MakeAtom("pP(fF(vz))")[0]}}};
+  REQUIRE(sub.bindings().size() == 2);
+
+  REQUIRE(sub.Apply(MakeAtom("pP(vx, vy, vz)")) ==
+          MakeAtom("pP(fF(vz), fF(vz), vz)"));
+  REQUIRE(sub.Apply(MakeAtom("pP(fG(vx), cA)")) ==
+          MakeAtom("pP(fG(fF(vz)), cA)"));
+
+  auto atom = MakeAtom("pP(fG(vx), vy)");
+  sub.Substitute(atom);
+  REQUIRE(atom == MakeAtom("pP(fG(fF(vz)), fF(vz))"));
+}
+
+TEST_CASE("substitution composition keeps the first binding",
+          "[unification][fol]") {
+  auto x_to_a = unification::Substitution{{{"vx", MakeAtom("pP(cA)")[0]}}};
+  auto x_to_b_y_to_x = unification::Substitution{
+      {{"vx", MakeAtom("pP(cB)")[0]},
+       {"vy", types::Term{lexer::Variable{std::string_view{"vx"}}}}}};
+
+  auto lhs = x_to_a;
+  lhs += x_to_b_y_to_x;
+  REQUIRE(lhs.bindings().size() == 2);
+  REQUIRE(Bound(lhs, "vx") == "cA");
+  // the binding of y is dereferenced through the one of x that was kept
+  REQUIRE(lhs.Apply(MakeAtom("pP(vx, vy)")) == MakeAtom("pP(cA, cA)"));
+
+  auto rhs = x_to_b_y_to_x;
+  rhs += x_to_a;
+  REQUIRE(rhs.bindings().size() == 2);
+  REQUIRE(Bound(rhs, "vx") == "cB");
+  REQUIRE(rhs.Apply(MakeAtom("pP(vx, vy)")) == MakeAtom("pP(cB, cB)"));
+}
+
+TEST_CASE("substitution drops self-cycles", "[unification][fol]") {
+  auto var = [](std::string_view name) {
+    return types::Term{lexer::Variable{name}};
+  };
+
+  unification::Substitution identity{{{"vx", var("vx")}}};
+  REQUIRE(identity.bindings().empty());
+  REQUIRE(identity.Apply(MakeAtom("pP(vx)")) == MakeAtom("pP(vx)"));
+
+  unification::Substitution cycle{{{"vx", var("vy")}, {"vy", var("vx")}}};
+  REQUIRE(cycle.bindings().size() == 1);
+  REQUIRE(cycle.Find("vy") == nullptr);
+  REQUIRE(cycle.Apply(MakeAtom("pP(vx, vy)")) == MakeAtom("pP(vy, vy)"));
+
+  unification::Substitution chain{
+      {{"vx", var("vy")}, {"vy", var("vz")}, {"vz", var("vx")}}};
+  REQUIRE(chain.bindings().size() == 2);
+  REQUIRE(chain.Apply(MakeAtom("pP(vx, vy, vz)")) ==
+          MakeAtom("pP(vz, vz, vz)"));
+
+  auto composed = unification::Substitution{{{"vx", var("vy")}}};
+  composed += unification::Substitution{{{"vy", var("vx")}}};
+  REQUIRE(composed.bindings().size() == 1);
+}
+
+TEST_CASE("substitution refreshes term info", "[unification][fol]") {
+  unification::Substitution sub{{{"vx", MakeAtom("pP(fF(cA, fG(cB)))")[0]}}};
+  auto atom = MakeAtom("pP(vx, fH(vx))");
+  REQUIRE_FALSE(atom.info().ground);
+
+  auto applied = sub.Apply(atom);
+  auto expected = MakeAtom("pP(fF(cA, fG(cB)), fH(fF(cA, fG(cB))))");
+  REQUIRE(applied.info().ground);
+  REQUIRE(applied.info().vars == 0);
+  REQUIRE(applied.info().depth == expected.info().depth);
+  REQUIRE(applied.info().weight == expected.info().weight);
+  REQUIRE(applied[1].info().ground);
+  REQUIRE(applied[1].info().depth == expected[1].info().depth);
+
+  sub.Substitute(atom);
+  REQUIRE(atom.info().ground);
+  REQUIRE(atom.info().vars == 0);
+  REQUIRE(atom.info().depth == expected.info().depth);
+  REQUIRE(atom.info().weight == expected.info().weight);
+  REQUIRE(atom[1].info().weight == expected[1].info().weight);
+}